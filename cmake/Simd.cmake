@@ -156,4 +156,16 @@ function(set_simd_instructions target_name)
         message(STATUS "Cannot set SIMD instructions to ${SIMD_INSTRUCTION_TYPE} for target '${target_name}' with '${CMAKE_CXX_COMPILER_ID}' compiler.")
     endif ()
 
-endfunction()
\ No newline at end of file
+endfunction()
+
+# Compile the SSE2/AVX2 kernels of the lexer without raising the baseline ISA of the whole target:
+# the best kernel is picked at runtime, so the same binary runs on hosts without AVX2.
+function(set_simd_dispatch target_name)
+    if (HAS_SSE2)
+        target_compile_definitions(${target_name} PRIVATE VANDIOR_SIMD_SSE2)
+    endif ()
+    if (HAS_AVX2)
+        target_compile_definitions(${target_name} PRIVATE VANDIOR_SIMD_AVX2)
+    endif ()
+    message(STATUS "Runtime SIMD dispatch for target '${target_name}': SSE2=${HAS_SSE2} AVX2=${HAS_AVX2}")
+endfunction()
@@ -18,6 +18,17 @@ namespace vnd {
          * @return A FolderCreationResult object indicating the result of the operation.
          */
         [[nodiscard]] static auto createFile(const fs::path &path, const std::string_view &fileName, const std::stringstream &fileContent)
+            -> FileCreationResult {
+            return createFile(path, fileName, fileContent.view());
+        }
+        /**
+         * @brief Create a file at the specified path, unless it already holds the content.
+         * @param path The path of the file to creat.
+         * @param fileName the name of the file.
+         * @param fileContent the content of the file.
+         * @return A FolderCreationResult object indicating the result of the operation.
+         */
+        [[nodiscard]] static auto createFile(const fs::path &path, const std::string_view &fileName, const std::string_view fileContent)
             -> FileCreationResult {
             const auto filePath = path / fileName;
             return createFileFromPath(filePath, fileContent);
@@ -29,33 +40,102 @@ namespace vnd {
          * @return A FolderCreationResult object indicating the result of the operation.
          */
         [[nodiscard]] static auto createFileFromPath(const fs::path &filePath, const std::stringstream &fileContent) -> FileCreationResult {
+            return createFileFromPath(filePath, fileContent.view());
+        }
+        /**
+         * @brief Create a file at the specified path, unless it already holds the content.
+         *
+         * A file that already holds the content is left untouched, so its modification time does not change and the
+         * build tools do not see it as out of date. Otherwise the content goes to a temporary file next to it, which
+         * is then renamed over it, so the file is never seen half written. The content is written in binary mode, byte
+         * for byte as given: a text mode stream would turn '\n' into "\r\n" on Windows and the file would never
+         * compare equal to its content again.
+         * @param filePath The path of the file create.
+         * @param fileContent the content of the file.
+         * @return A FolderCreationResult object indicating the result of the operation.
+         */
+        [[nodiscard]] static auto createFileFromPath(const fs::path &filePath, const std::string_view fileContent) -> FileCreationResult {
+            const auto tempPath = temporaryPath(filePath);
             try {
-                std::ofstream outfile(filePath);
+                if(hasContent(filePath, fileContent)) {
+#ifdef INDEPT
+                    LINFO("File '{}' is up to date.", filePath);
+#endif
+                    return {true, filePath};
+                }
+                std::ofstream outfile(tempPath, std::ios::binary);
                 if(!outfile.is_open()) {
-                    LERROR("Failed to open file {}", filePath);
+                    LERROR("Failed to open file {}", tempPath);
                     return {false, filePath};
                 }
-                outfile << fileContent.rdbuf();
+                outfile.write(fileContent.data(), static_cast<std::streamsize>(fileContent.size()));
                 outfile.close();
-                if(fs::exists(filePath)) {
+                if(!outfile) {
+                    LERROR("Failed to write '{}'", tempPath);
+                    removeTemporary(tempPath);
+                    return {false, filePath};
+                }
+                fs::rename(tempPath, filePath);
 #ifdef INDEPT
-                    LINFO("File '{}' created successfully.", filePath);
+                LINFO("File '{}' created successfully.", filePath);
 #endif
-                    return {true, filePath};
-                } else {
-                    LERROR("Failed to create '{}'", filePath);
-                }
-                return {false, filePath};
+                return {true, filePath};
             } catch(const fs::filesystem_error &e) {
                 LERROR("Filesystem error while creating file '{}': {}", filePath, e.what());
-                return {false, filePath};
             } catch(const std::exception &e) {
                 LERROR("Exception while creating file '{}': {}", filePath, e.what());
-                return {false, filePath};
             } catch(...) {
                 LERROR("An unknown error occurred while creating file '{}'.", filePath);
-                return {false, filePath};
             }
+            removeTemporary(tempPath);
+            return {false, filePath};
+        }
+
+    private:
+        /**
+         * @brief Names a temporary file next to the given file, unique to this call.
+         *
+         * A random tag drawn once per process tells concurrent runs apart, a counter the calls within the run.
+         * @param filePath The path of the file.
+         * @return The path of the temporary file.
+         */
+        [[nodiscard]] static auto temporaryPath(const fs::path &filePath) -> fs::path {
+            static const auto processTag = std::random_device{}();
+            static std::atomic<std::uint64_t> counter{0};
+            auto tempPath = filePath;
+            tempPath += FORMAT(".{:08x}-{}.tmp", processTag, counter.fetch_add(1, std::memory_order_relaxed));
+            return tempPath;
+        }
+
+        /**
+         * @brief Checks whether a file already holds the given content: the sizes first, then the bytes chunk by chunk.
+         * @param filePath The path of the file.
+         * @param content The content.
+         * @return True if the file exists and holds exactly the content.
+         */
+        [[nodiscard]] static bool hasContent(const fs::path &filePath, const std::string_view content) {
+            static constexpr std::size_t chunkSize = 64 * 1024;
+            std::error_code error;
+            if(const auto size = fs::file_size(filePath, error); error || size != content.size()) { return false; }
+            std::ifstream infile(filePath, std::ios::binary);
+            if(!infile.is_open()) { return false; }
+            std::string chunk(std::min(chunkSize, content.size()), '\0');
+            for(std::size_t offset = 0; offset < content.size();) {
+                const auto count = std::min(chunkSize, content.size() - offset);
+                if(!infile.read(chunk.data(), static_cast<std::streamsize>(count))) { return false; }
+                if(content.substr(offset, count) != std::string_view{chunk.data(), count}) { return false; }
+                offset += count;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Removes the temporary file of a failed write, if it was created.
+         * @param tempPath The path of the temporary file.
+         */
+        static void removeTemporary(const fs::path &tempPath) noexcept {
+            std::error_code error;
+            fs::remove(tempPath, error);
         }
     };
 }  // namespace vnd
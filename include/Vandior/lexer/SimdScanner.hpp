@@ -0,0 +1,101 @@
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+#include "../headers.hpp"
+
+namespace vnd {
+
+    /**
+     * @brief Instruction set used by the SimdScanner kernels.
+     */
+    enum class SimdLevel : std::uint8_t {
+        Scalar,  ///< Portable byte-at-a-time loop.
+        SSE2,    ///< 16 bytes per step.
+        AVX2     ///< 32 bytes per step.
+    };
+
+    /**
+     * @brief Result of a bulk scan that may cross line boundaries.
+     */
+    struct ScanResult {
+        std::size_t position;   ///< Position of the first byte that stopped the scan (or the input size).
+        std::size_t newlines;   ///< Number of line breaks skipped ('\n', '\r\n' and lone '\r' each count once).
+        std::size_t lineStart;  ///< Position right after the last skipped line break, npos if none was skipped.
+    };
+
+    /**
+     * @brief Vectorized scanning kernels used by the tokenizer to skip comments, strings, whitespace and identifiers.
+     *
+     * The best instruction set supported by both the build and the running CPU is selected at runtime,
+     * so the same binary runs on hosts without AVX2.
+     */
+    class SimdScanner {
+    public:
+        /**
+         * @brief Detects the best instruction set available on this CPU and compiled into this build.
+         * @return The detected SimdLevel.
+         */
+        [[nodiscard]] static SimdLevel detectLevel() noexcept;
+
+        /**
+         * @brief Gets the instruction set currently used by the kernels.
+         * @return The active SimdLevel.
+         */
+        [[nodiscard]] static SimdLevel level() noexcept;
+
+        /**
+         * @brief Forces the instruction set used by the kernels, clamped to the detected one.
+         * @param level The requested SimdLevel.
+         */
+        static void setLevel(SimdLevel level) noexcept;
+
+        /**
+         * @brief Finds the next '\n'.
+         * @param input The input text.
+         * @param pos The starting position.
+         * @return Position of the next '\n', or the input size.
+         */
+        [[nodiscard]] static std::size_t findNewline(const std::string_view input, std::size_t pos) noexcept;
+
+        /**
+         * @brief Finds the next "*" "/" pair, counting the line breaks before it.
+         * @param input The input text.
+         * @param pos The starting position (just after the opening delimiter).
+         * @return The position of the closing '*' (or the input size) and the skipped lines.
+         */
+        [[nodiscard]] static ScanResult skipBlockComment(const std::string_view input, std::size_t pos) noexcept;
+
+        /**
+         * @brief Finds the next '"', counting the line breaks before it.
+         * @param input The input text.
+         * @param pos The starting position (just after the opening quote).
+         * @return The position of the closing quote (or the input size) and the skipped lines.
+         */
+        [[nodiscard]] static ScanResult skipString(const std::string_view input, std::size_t pos) noexcept;
+
+        /**
+         * @brief Skips whitespace, counting the line breaks.
+         * @param input The input text.
+         * @param pos The starting position.
+         * @return The position of the first non whitespace byte (or the input size) and the skipped lines.
+         */
+        [[nodiscard]] static ScanResult skipWhitespace(const std::string_view input, std::size_t pos) noexcept;
+
+        /**
+         * @brief Skips identifier bytes ([A-Za-z0-9_]).
+         * @param input The input text.
+         * @param pos The starting position.
+         * @return Position of the first non identifier byte, or the input size.
+         */
+        [[nodiscard]] static std::size_t skipIdentifier(const std::string_view input, std::size_t pos) noexcept;
+
+        /**
+         * @brief Collects the offset of the first byte of every line.
+         * @param input The input text, at most 4 GiB.
+         * @return The line starts, beginning with 0 ('\n', '\r\n' and lone '\r' each end a line).
+         */
+        [[nodiscard]] static std::vector<std::uint32_t> lineStarts(const std::string_view input);
+    };
+
+}  // namespace vnd
+
+// NOLINTEND(*-include-cleaner)
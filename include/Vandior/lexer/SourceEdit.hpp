@@ -0,0 +1,62 @@
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "SourceManager.hpp"
+#include <functional>
+
+namespace vnd {
+
+    /**
+     * @brief A text edit: the bytes [begin, end) of an input are replaced by a new text.
+     */
+    struct SourceEdit {
+        std::size_t begin;             ///< Offset of the first replaced byte.
+        std::size_t end;               ///< Offset one past the last replaced byte, in the input before the edit.
+        std::string_view replacement;  ///< The text inserted in place of the replaced bytes.
+
+        /**
+         * @brief Gets how far the bytes after the edit move.
+         * @return The size of the replacement minus the size of the replaced range.
+         */
+        [[nodiscard]] std::int64_t shift() const noexcept { return C_I64T(replacement.size()) - C_I64T(end - begin); }
+
+        /**
+         * @brief Applies the edit.
+         * @param input The input before the edit.
+         * @return The input after the edit.
+         */
+        [[nodiscard]] std::string apply(const std::string_view input) const {
+            std::string result;
+            result.reserve(input.size() - (end - begin) + replacement.size());
+            result.append(input.substr(0, begin)).append(replacement).append(input.substr(end));
+            return result;
+        }
+    };
+
+    /**
+     * @brief Moves tokens and views from one registered source to another whose text holds the same bytes shifted.
+     *
+     * Used to keep the tokens and the AST nodes an edit did not touch: only what points into the from entry moves.
+     */
+    struct SourceShift {
+        FileId from;                ///< The entry the tokens point into.
+        FileId to;                  ///< The entry to point into instead.
+        std::string_view fromText;  ///< The text of the from entry.
+        std::string_view toText;    ///< The text of the to entry.
+        std::int64_t delta{0};      ///< The shift of the offsets.
+
+        /**
+         * @brief Moves a view into the from text to the to text.
+         * @param view The view.
+         * @return The moved view, or the view itself if it does not point into the from text.
+         */
+        [[nodiscard]] std::string_view apply(const std::string_view view) const noexcept {
+            const auto *fromBegin = fromText.data();
+            if(std::less{}(view.data(), fromBegin) || std::greater{}(view.data(), fromBegin + fromText.size())) { return view; }
+            return toText.substr(C_ST(C_I64T(view.data() - fromBegin) + delta), view.size());
+        }
+    };
+
+}  // namespace vnd
+
+// NOLINTEND(*-include-cleaner)
@@ -0,0 +1,174 @@
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "CodeSourceLocation.hpp"
+
+namespace vnd {
+
+    /// Index of a source in the SourceManager table.
+    using FileId = std::uint32_t;
+
+    struct SourceEdit;
+
+    /**
+     * @brief A source registered in the SourceManager.
+     *
+     * A file entry views a whole input and resolves byte offsets to line and column through its line-start table.
+     * A synthetic entry holds a single value with a fixed location, for tokens built outside the tokenizer.
+     */
+    struct SourceFile {
+        std::string_view fileName;                ///< The name of the source file.
+        std::string_view text;                    ///< The source text (not owned).
+        std::vector<std::uint32_t> lineStarts{};  ///< Offset of the first byte of every line, empty for synthetic entries.
+        std::size_t line{0};                      ///< Fixed line of a synthetic entry.
+        std::size_t column{0};                    ///< Fixed column of a synthetic entry.
+
+        [[nodiscard]] bool isSynthetic() const noexcept { return lineStarts.empty(); }
+
+        /**
+         * @brief Finds the line holding a byte offset, with a binary search on the line-start table.
+         * @param offset The byte offset in text (not valid for synthetic entries).
+         * @return The 1-based line number.
+         */
+        [[nodiscard]] std::size_t lineOf(std::size_t offset) const noexcept;
+
+        /**
+         * @brief Gets the text of a line without its line break.
+         * @param lineNumber The 1-based line number (not valid for synthetic entries).
+         * @return The line text.
+         */
+        [[nodiscard]] std::string_view lineText(std::size_t lineNumber) const noexcept;
+
+        /**
+         * @brief Resolves a byte offset to its source location.
+         * @param offset The byte offset in text.
+         * @return The location of the offset.
+         */
+        [[nodiscard]] CodeSourceLocation locate(std::uint32_t offset) const noexcept;
+    };
+
+    /**
+     * @brief Process-wide table of the sources tokens point into.
+     *
+     * Tokens store a FileId and a byte range instead of a value and a location, and ask the table to rebuild them.
+     * A file entry lives until its owner releases it, usually through a SourceHandle, and its slot is then handed out
+     * again under a new id, as a FileId carries the generation of its slot: ids are never handed out twice, and reading
+     * a released entry fails an assertion in debug builds. Synthetic entries live for the whole run. The texts and file names are views with the same lifetime
+     * requirements the tokens had before. Lookups are lock-free; registration and release take a lock.
+     */
+    class SourceManager {
+    public:
+        /// The id of the synthetic entry for the default "unknown" location with an empty value.
+        static inline constexpr FileId unknownFileId = 0;
+
+        /**
+         * @brief Registers an input and builds its line-start table.
+         * @param fileName The name of the file.
+         * @param text The source text, at most 4 GiB.
+         * @return The id of the new entry.
+         * @throws std::length_error if text does not fit 32-bit offsets.
+         */
+        [[nodiscard]] static FileId addFile(std::string_view fileName, std::string_view text);
+
+        /**
+         * @brief Points a file entry to another input, rebuilding its line-start table in place.
+         *
+         * The tokens pointing into the entry then read the new input. Only the owner of the entry may rebind it.
+         * @param fileId The id returned by addFile().
+         * @param fileName The name of the file.
+         * @param text The source text, at most 4 GiB.
+         * @throws std::length_error if text does not fit 32-bit offsets.
+         */
+        static void rebind(FileId fileId, std::string_view fileName, std::string_view text);
+
+        /**
+         * @brief Points a file entry to its text after an edit, patching its line-start table around the edit.
+         *
+         * Only the line starts from the line before the edit to the end of the replacement are scanned again, the
+         * later ones are shifted. Only the owner of the entry may rebind it.
+         * @param fileId The id returned by addFile().
+         * @param text The source text after the edit, at most 4 GiB.
+         * @param edit The edit that turned the text of the entry into text.
+         * @throws std::length_error if text does not fit 32-bit offsets.
+         */
+        static void rebind(FileId fileId, std::string_view text, const SourceEdit &edit);
+
+        /**
+         * @brief Frees a file entry and its line-start table, so a later addFile() can reuse its slot.
+         *
+         * No token pointing into the entry may be read afterwards, nor while the release runs.
+         * @param fileId The id returned by addFile().
+         */
+        static void release(FileId fileId);
+
+        /**
+         * @brief Gets (or creates) the synthetic entry for a value with a fixed location.
+         * @param value The token value.
+         * @param location The token location.
+         * @return The id of the entry.
+         */
+        [[nodiscard]] static FileId addSynthetic(std::string_view value, const CodeSourceLocation &location);
+
+        /**
+         * @brief Gets a registered entry.
+         * @param fileId The id returned at registration, whose entry has not been released.
+         * @return The entry.
+         */
+        [[nodiscard]] static const SourceFile &get(FileId fileId) noexcept;
+
+        /**
+         * @brief Gets the number of live entries.
+         * @return The entries registered and not released, synthetic ones included.
+         */
+        [[nodiscard]] static std::size_t size();
+    };
+
+    /**
+     * @brief Owner of a SourceManager file entry, released when the handle is destroyed.
+     */
+    class SourceHandle {
+    public:
+        /**
+         * @brief Constructs an empty handle, owning no entry.
+         */
+        SourceHandle() noexcept = default;
+
+        /**
+         * @brief Registers an input and takes ownership of its entry.
+         * @param fileName The name of the file.
+         * @param text The source text, at most 4 GiB.
+         */
+        SourceHandle(const std::string_view fileName, const std::string_view text) : _fileId(SourceManager::addFile(fileName, text)) {}
+
+        SourceHandle(const SourceHandle &other) = delete;
+        SourceHandle &operator=(const SourceHandle &other) = delete;
+
+        SourceHandle(SourceHandle &&other) noexcept : _fileId(std::exchange(other._fileId, SourceManager::unknownFileId)) {}
+
+        SourceHandle &operator=(SourceHandle &&other) noexcept {
+            if(this != &other) {
+                reset();
+                _fileId = std::exchange(other._fileId, SourceManager::unknownFileId);
+            }
+            return *this;
+        }
+
+        ~SourceHandle() { reset(); }
+
+        /**
+         * @brief Releases the owned entry, if any.
+         */
+        void reset() noexcept {
+            if(_fileId != SourceManager::unknownFileId) { SourceManager::release(std::exchange(_fileId, SourceManager::unknownFileId)); }
+        }
+
+        [[nodiscard]] FileId get() const noexcept { return _fileId; }
+        [[nodiscard]] explicit operator bool() const noexcept { return _fileId != SourceManager::unknownFileId; }
+
+    private:
+        FileId _fileId{SourceManager::unknownFileId};  ///< The owned entry, or the unknown entry if the handle is empty.
+    };
+
+}  // namespace vnd
+
+// NOLINTEND(*-include-cleaner)
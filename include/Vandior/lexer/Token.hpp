@@ -3,6 +3,8 @@
 
 #include "CodeSourceLocation.hpp"
 #include "CompTokenType.hpp"
+#include "SourceEdit.hpp"
+#include <cassert>
 
 DISABLE_WARNINGS_PUSH(4820)
 
@@ -10,6 +12,10 @@ namespace vnd {
 
     /**
      * @brief Represents a token used in some lexical analysis.
+     *
+     * A token is 16 bytes: the byte range of its value in a SourceManager entry, the entry id and the type.
+     * The value and the source location are rebuilt from the entry on demand, so a token may be read only while its
+     * entry is alive: for the tokens of a Tokenizer, as long as the tokenizer that lexed them.
      */
     class Token {
     public:
@@ -17,7 +23,7 @@ namespace vnd {
          * @brief Default constructor for Token.
          * Initializes the token with UNKNOWN type and default values for other members.
          */
-        Token() noexcept : Token(TokenType::UNKNOWN, "", CodeSourceLocation::unknown()) {}  // NOLINT(*-redundant-member-init)
+        Token() noexcept : _fileId(SourceManager::unknownFileId), _type(TokenType::UNKNOWN) {}
 
         /**
          * @brief Parameterized constructor for Token.
@@ -26,8 +32,8 @@ namespace vnd {
          * @param value The value associated with the token.
          * @param sourceLocation The source location where the token appears.
          */
-        Token(TokenType type, const std::string_view value, const CodeSourceLocation &sourceLocation) noexcept
-          : _type(type), _value(value), _sourceLocation{sourceLocation} {}
+        Token(TokenType type, const std::string_view value, const CodeSourceLocation &sourceLocation)
+          : _length(C_UI32T(value.size())), _fileId(SourceManager::addSynthetic(value, sourceLocation)), _type(type) {}
 
         /**
          * @brief Parameterized constructor for Token with an empty value.
@@ -35,8 +41,17 @@ namespace vnd {
          * @param type The type of the token.
          * @param sourceLocation The source location where the token appears.
          */
-        Token(TokenType type, const CodeSourceLocation &sourceLocation) noexcept
-          : _type(type), _value(""), _sourceLocation{sourceLocation} {}
+        Token(TokenType type, const CodeSourceLocation &sourceLocation) : Token(type, ""sv, sourceLocation) {}
+
+        /**
+         * @brief Constructs a token over a byte range of a registered source.
+         * @param type The type of the token.
+         * @param fileId The SourceManager entry holding the source.
+         * @param offset The offset of the value in the source.
+         * @param length The length of the value.
+         */
+        Token(TokenType type, FileId fileId, std::uint32_t offset, std::uint32_t length) noexcept
+          : _offset(offset), _length(length), _fileId(fileId), _type(type) {}
 
         /**
          * @brief Copy constructor for Token.
@@ -96,33 +111,63 @@ namespace vnd {
          * @brief Get the value associated with the token.
          * @return The value associated with the token.
          */
-        [[nodiscard]] std::string_view getValue() const noexcept { return _value; }
+        [[nodiscard]] std::string_view getValue() const noexcept {
+            const auto text = SourceManager::get(_fileId).text;
+            assert(C_ST(_offset) + _length <= text.size() && "the token is past the end of its source");
+            return {text.data() + _offset, _length};  // NOLINT(*-pro-bounds-pointer-arithmetic)
+        }
 
         /**
          * @brief Get the size of the value associated with the token.
          * @return The value associated with the token.
          */
-        [[nodiscard]] std::size_t getValueSize() const noexcept { return _value.size(); }
+        [[nodiscard]] std::size_t getValueSize() const noexcept { return _length; }
 
         /**
          * @brief Get the file name where the token appears.
          * @return The file name.
          */
-        [[nodiscard]] const std::string_view getFileName() const noexcept { return _sourceLocation.getFileName(); }
+        [[nodiscard]] const std::string_view getFileName() const noexcept { return SourceManager::get(_fileId).fileName; }
+
+        /**
+         * @brief Get the source location of the token.
+         * @return The location of the first byte of the value.
+         */
+        [[nodiscard]] CodeSourceLocation getSourceLocation() const noexcept { return SourceManager::get(_fileId).locate(_offset); }
+
+        /**
+         * @brief Get the SourceManager entry the token points into.
+         * @return The file id.
+         */
+        [[nodiscard]] FileId getFileId() const noexcept { return _fileId; }
 
-        [[nodiscard]] const CodeSourceLocation &getSourceLocation() const noexcept { return _sourceLocation; }
+        /**
+         * @brief Get the offset of the value in its source.
+         * @return The byte offset.
+         */
+        [[nodiscard]] std::uint32_t getOffset() const noexcept { return _offset; }
 
         /**
          * @brief Get the line number where the token appears.
          * @return The line number.
          */
-        [[nodiscard]] std::size_t getLine() const noexcept { return _sourceLocation.getLine(); }
+        [[nodiscard]] std::size_t getLine() const noexcept { return getSourceLocation().getLine(); }
 
         /**
          * @brief Get the column number where the token appears.
          * @return The column number.
          */
-        [[nodiscard]] std::size_t getColumn() const noexcept { return _sourceLocation.getColumn(); }
+        [[nodiscard]] std::size_t getColumn() const noexcept { return getSourceLocation().getColumn(); }
+
+        /**
+         * @brief Moves the token to another source, if it points into the one being replaced.
+         * @param shift The source change.
+         */
+        void rebase(const SourceShift &shift) noexcept {
+            if(_fileId != shift.from) { return; }
+            _fileId = shift.to;
+            _offset = C_UI32T(C_I64T(_offset) + shift.delta);
+        }
 
         /**
          * @brief Convert the token to a string representation.
@@ -146,50 +191,63 @@ namespace vnd {
          * @brief Set the value associated with the token.
          * @param value The value to set.
          */
-        void setValue(std::string_view value) noexcept { _value = value; }
+        void setValue(std::string_view value) { *this = Token{_type, value, getSourceLocation()}; }
 
         /**
          * @brief Set the file name where the token appears.
          * @param fileName The file name to set.
          */
-        void setFileName(const std::string_view &fileName) noexcept { _sourceLocation.setFileName(fileName); }
+        void setFileName(const std::string_view &fileName) { setSourceLocation({fileName, getLine(), getColumn()}); }
 
         /**
          * @brief Set the line number where the token appears.
          * @param line The line number to set.
          */
-        void setLine(std::size_t line) noexcept { _sourceLocation.setLine(line); }
+        void setLine(std::size_t line) { setSourceLocation({getFileName(), line, getColumn()}); }
 
         /**
          * @brief Set the column number where the token appears.
          * @param column The column number to set.
          */
-        void setColumn(std::size_t column) noexcept { _sourceLocation.setColumn(column); }
+        void setColumn(std::size_t column) { setSourceLocation({getFileName(), getLine(), column}); }
 
         /**
          * @brief Default comparison operator for Tokens.
          * @return True if the tokens are equal, false otherwise.
          */
-        auto operator<=>(const Token &) const = default;
+        auto operator<=>(const Token &other) const noexcept {
+            if(const auto cmp = _type <=> other._type; cmp != 0) { return cmp; }
+            if(const auto cmp = getValue() <=> other.getValue(); cmp != 0) { return cmp; }
+            return getSourceLocation() <=> other.getSourceLocation();
+        }
 
         /**
          * @brief Equality operator.
          * @param other The token to compare with.
          * @return True if the tokens are equal, false otherwise.
          */
-        bool operator==(const Token &other) const noexcept = default;
+        bool operator==(const Token &other) const noexcept {
+            return _type == other._type && getValue() == other.getValue() && getSourceLocation() == other.getSourceLocation();
+        }
 
         /**
          * @brief Inequality operator.
          * @param other The token to compare with.
          * @return True if the tokens are not equal, false otherwise.
          */
-        bool operator!=(const Token &other) const noexcept = default;
+        bool operator!=(const Token &other) const noexcept { return !(*this == other); }
 
     private:
-        TokenType _type;                     ///< The type of the token.
-        std::string_view _value;             ///< The value associated with the token.
-        CodeSourceLocation _sourceLocation;  ///< The token source location.
+        std::uint32_t _offset{0};  ///< Offset of the value in the source.
+        std::uint32_t _length{0};  ///< Length of the value.
+        FileId _fileId;            ///< SourceManager entry holding the source.
+        TokenType _type;           ///< The type of the token.
+
+        /**
+         * @brief Re-points the token to a synthetic entry with the current value and the given location.
+         * @param sourceLocation The new location.
+         */
+        void setSourceLocation(const CodeSourceLocation &sourceLocation) { *this = Token{_type, getValue(), sourceLocation}; }
     };
 
     using TokenVec = std::vector<Token>;
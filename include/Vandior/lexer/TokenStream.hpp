@@ -0,0 +1,194 @@
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "Token.hpp"
+#include <span>
+
+namespace vnd {
+
+    /// Read-only view over the tokens of one statement.
+    using TokenSpan = std::span<const Token>;
+
+    /**
+     * @brief Half-open range [begin, end) of token indices making up one statement.
+     */
+    struct StatementRange {
+        std::size_t begin;  ///< Index of the first token of the statement.
+        std::size_t end;    ///< Index one past the last token of the statement.
+
+        [[nodiscard]] constexpr std::size_t size() const noexcept { return end - begin; }
+        constexpr bool operator==(const StatementRange &other) const noexcept = default;
+    };
+
+    /**
+     * @brief Tokens of a whole source kept in a single contiguous buffer, plus the statement boundaries.
+     *
+     * Statements are exposed as spans into the shared buffer, so splitting the input in statements costs two
+     * indices per statement instead of one heap vector each.
+     */
+    class TokenStream {
+    public:
+        /**
+         * @brief Forward iterator yielding each statement as a TokenSpan.
+         */
+        class const_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = TokenSpan;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = TokenSpan;
+
+            const_iterator() noexcept = default;
+            const_iterator(const TokenStream *stream, std::size_t index) noexcept : _stream(stream), _index(index) {}
+
+            [[nodiscard]] TokenSpan operator*() const noexcept { return (*_stream)[_index]; }
+            const_iterator &operator++() noexcept {
+                ++_index;
+                return *this;
+            }
+            const_iterator operator++(int) noexcept {
+                auto copy = *this;
+                ++_index;
+                return copy;
+            }
+            bool operator==(const const_iterator &other) const noexcept = default;
+
+        private:
+            const TokenStream *_stream{nullptr};
+            std::size_t _index{0};
+        };
+
+        TokenStream() noexcept = default;
+
+        /**
+         * @brief Constructs an empty stream whose token buffer comes from a memory resource, such as an ArenaResource.
+         * @param resource The resource; it must outlive the stream.
+         */
+        explicit TokenStream(std::pmr::memory_resource *resource) noexcept : _tokens(resource) {}
+
+        /**
+         * @brief Reserves the token buffer and the statement index.
+         * @param tokenCount Estimated number of tokens.
+         * @param statementCount Estimated number of statements.
+         */
+        void reserve(std::size_t tokenCount, std::size_t statementCount) {
+            _tokens.reserve(tokenCount);
+            _statements.reserve(statementCount);
+        }
+
+        /**
+         * @brief Drops every token and statement, keeping the buffers for reuse.
+         */
+        void clear() noexcept {
+            _tokens.clear();
+            _statements.clear();
+            _statementStart = 0;
+        }
+
+        /**
+         * @brief Appends whole statements of another stream, moving their tokens to another source.
+         * @param source The stream to copy from.
+         * @param first The first statement to copy.
+         * @param last One past the last statement to copy.
+         * @param shift How to move the copied tokens.
+         * @pre The statement being built holds no token.
+         */
+        void append(const TokenStream &source, std::size_t first, std::size_t last, const SourceShift &shift) {
+            if(first == last) { return; }
+            const auto sourceBegin = source._statements[first].begin;
+            const auto base = _tokens.size();
+            _tokens.insert(_tokens.end(), std::next(source._tokens.begin(), C_PTRDIFT(sourceBegin)),
+                           std::next(source._tokens.begin(), C_PTRDIFT(source._statements[last - 1].end)));
+            for(auto index = base; index < _tokens.size(); ++index) { _tokens[index].rebase(shift); }
+            for(auto index = first; index < last; ++index) {
+                const auto &range = source._statements[index];
+                _statements.emplace_back(range.begin - sourceBegin + base, range.end - sourceBegin + base);
+            }
+            _statementStart = _tokens.size();
+        }
+
+        /**
+         * @brief Appends a token to the statement being built.
+         * @param args The Token constructor arguments.
+         */
+        template <typename... Args> void emplace_back(Args &&...args) { _tokens.emplace_back(std::forward<Args>(args)...); }
+
+        /**
+         * @brief Closes the statement being built, even if it holds no token.
+         */
+        void closeStatement() {
+            _statements.emplace_back(_statementStart, _tokens.size());
+            _statementStart = _tokens.size();
+        }
+
+        /**
+         * @brief Gets the number of statements.
+         * @return The number of closed statements.
+         */
+        [[nodiscard]] std::size_t size() const noexcept { return _statements.size(); }
+
+        /**
+         * @brief Checks if the stream holds no statement.
+         * @return True if there are no statements, false otherwise.
+         */
+        [[nodiscard]] bool empty() const noexcept { return _statements.empty(); }
+
+        /**
+         * @brief Gets the total number of tokens across all statements.
+         * @return The size of the token buffer.
+         */
+        [[nodiscard]] std::size_t tokenCount() const noexcept { return _tokens.size(); }
+
+        /**
+         * @brief Gets the whole token buffer.
+         * @return The tokens of every statement, in source order.
+         */
+        [[nodiscard]] TokenSpan tokens() const noexcept { return _tokens; }
+
+        /**
+         * @brief Gets the statement boundaries.
+         * @return The token range of every statement, in source order.
+         */
+        [[nodiscard]] const std::vector<StatementRange> &statements() const noexcept { return _statements; }
+
+        [[nodiscard]] TokenSpan operator[](std::size_t index) const noexcept {
+            const auto &range = _statements[index];
+            return TokenSpan{_tokens}.subspan(range.begin, range.size());
+        }
+
+        /**
+         * @brief Gets a statement as a mutable span, for consumers that rewrite tokens in place.
+         * @param index The statement index.
+         * @return The tokens of the statement.
+         */
+        [[nodiscard]] std::span<Token> mutableStatement(std::size_t index) noexcept {
+            const auto &range = _statements[index];
+            return std::span<Token>{_tokens}.subspan(range.begin, range.size());
+        }
+
+        /**
+         * @brief Gets a statement with bounds checking.
+         * @param index The statement index.
+         * @return The tokens of the statement.
+         * @throws std::out_of_range if index is not a valid statement index.
+         */
+        [[nodiscard]] TokenSpan at(std::size_t index) const {
+            if(index >= _statements.size()) { throw std::out_of_range("TokenStream::at: statement index out of range"); }
+            return (*this)[index];
+        }
+
+        [[nodiscard]] TokenSpan front() const noexcept { return (*this)[0]; }
+        [[nodiscard]] TokenSpan back() const noexcept { return (*this)[_statements.size() - 1]; }
+        [[nodiscard]] const_iterator begin() const noexcept { return {this, 0}; }
+        [[nodiscard]] const_iterator end() const noexcept { return {this, _statements.size()}; }
+
+    private:
+        std::pmr::vector<Token> _tokens;          ///< The tokens of all statements.
+        std::vector<StatementRange> _statements;  ///< The token range of each statement.
+        std::size_t _statementStart{0};           ///< First token of the statement being built.
+    };
+
+}  // namespace vnd
+
+// NOLINTEND(*-include-cleaner)
@@ -2,12 +2,28 @@
 // NOLINTBEGIN(*-include-cleaner)
 
 #include "ErrorHandler.hpp"
+#include "SimdScanner.hpp"
 #include "Token.hpp"
+#include "TokenStream.hpp"
 #include "TokenizerConstants.hpp"
 #include "TokenizerUtility.hpp"
+#include <future>
 #include <string>
 
 namespace vnd {
+    /**
+     * @brief Result of an incremental Tokenizer::tokenize().
+     *
+     * The statements before relexBegin are the previous ones, the statements in [relexBegin, relexEnd) were lexed again
+     * and the statements from relexEnd on are the previous ones from previousRelexEnd on.
+     */
+    struct RelexResult {
+        TokenStream tokens;            ///< The tokens of the edited input.
+        std::size_t relexBegin;        ///< The first statement lexed again.
+        std::size_t relexEnd;          ///< One past the last statement lexed again.
+        std::size_t previousRelexEnd;  ///< The previous statement matching the statement at relexEnd.
+    };
+
     /**
      * @brief Tokenizer class for parsing input strings.
      */
@@ -17,28 +33,165 @@ namespace vnd {
          * @brief Constructor for Tokenizer.
          * @param input The input string to tokenize.
          * @param fileName The name of the file being tokenized (default: "unknown.vn").
+         * @param resource Where the token buffer is allocated; it must outlive the tokenizer and its results.
+         */
+        explicit Tokenizer(const std::string_view &input, const std::string_view &fileName = "unknown.vn",
+                           std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+          : tokens(resource), _input(input), _filename(fileName), _inputSize(input.size()), _source(fileName, input), _fileId(_source.get()) {}
+
+        /**
+         * @brief Constructs a fresh tokenizer, at the start of the input of another one, without registering that
+         * input again in the SourceManager; nothing else is copied. The entry stays owned by the other tokenizer, which
+         * must outlive this one.
+         * @param other The tokenizer whose input, file name and SourceManager entry are shared.
+         * @param resource Where the token buffer is allocated; it must outlive the tokenizer and its results.
+         */
+        Tokenizer(const Tokenizer &other, std::pmr::memory_resource *resource)
+          : tokens(resource), _input(other._input), _filename(other._filename), _inputSize(other._inputSize), _fileId(other._fileId) {}
+
+        /**
+         * @brief Rebinds the tokenizer to a new input, keeping the buffers it has already grown.
+         *
+         * The SourceManager entry of the tokenizer is pointed to the input in place, unless it is the very buffer
+         * already bound, with the same file name: rebinding to it, to lex it again, allocates nothing. Tokens lexed
+         * before the reset read the new input from then on.
+         * @param input The input string to tokenize.
+         * @param fileName The name of the file being tokenized (default: "unknown.vn").
+         */
+        void reset(const std::string_view &input, const std::string_view &fileName = "unknown.vn");
+
+        /**
+         * @brief Tokenize the input string from its beginning.
+         * @return The tokens of the input, split in statements.
+         */
+        [[nodiscard]] TokenStream tokenize();
+
+        /**
+         * @brief Tokenize the input string from its beginning into the tokenizer's own stream.
+         *
+         * Unlike tokenize(), the stream keeps its capacity for the next run, so lexing again an input that fits in
+         * it allocates nothing.
+         * @return The tokens of the input, valid until the next run or reset().
+         */
+        [[nodiscard]] const TokenStream &lex();
+
+        /**
+         * @brief Tokenize the input string after an edit, lexing only the statements the edit touched.
+         *
+         * Lexing restarts at the last statement starting before the edit, with the bracket state rebuilt from the
+         * previous tokens, and stops at the first statement start past the edit where the previous stream had a
+         * statement start with the same state. The rest of the previous stream is shifted and reused.
+         * @param previous The tokens of the input before the edit.
+         * @param edit The edit that turned the previous input into the input of this tokenizer.
+         * @return The tokens of the input and the statements lexed again.
          */
-        explicit Tokenizer(const std::string_view &input, const std::string_view &fileName = "unknown.vn") noexcept
-          : _input(input), _filename(fileName), _inputSize(input.size()) /*_locationAllocator(_inputSize)*/ {}
+        [[nodiscard]] RelexResult tokenize(const TokenStream &previous, const SourceEdit &edit);
 
         /**
-         * @brief Tokenize the input string.
-         * @return A vector of Token objects.
+         * @brief Moves the tokenizer to its input after an edit and tokenizes it, lexing only the statements the edit
+         * touched.
+         *
+         * Unlike tokenize(previous, edit) on a tokenizer built for the edited input, the SourceManager entry of this
+         * tokenizer is patched around the edit in place: an editing session keeps a single entry per document and
+         * never rebuilds its whole line-start table. The previous tokens read the new input from then on.
+         * @param previous The tokens of the current input of this tokenizer.
+         * @param input The input after the edit.
+         * @param edit The edit that turned the current input into input.
+         * @return The tokens of the input and the statements lexed again.
          */
-        [[nodiscard]] std::vector<TokenVec> tokenize();
+        [[nodiscard]] RelexResult tokenize(const TokenStream &previous, const std::string_view &input, const SourceEdit &edit);
+
+        /// Smallest chunk worth a thread of its own in tokenizeParallel().
+        static inline constexpr std::size_t defaultMinChunkSize = 1024 * 1024;
+
+        /**
+         * @brief Tokenize the input string on several threads, with the same result as tokenize().
+         *
+         * The input is split at line starts and the chunks are lexed concurrently, then stitched in order: the
+         * statements are rebuilt from the bracket state while the chunks are appended. A chunk that turns out to
+         * start inside a multi-line token of the previous one is lexed again from where that token ends.
+         * @param threadCount The number of chunks, 0 for the hardware concurrency.
+         * @param minChunkSize Inputs too small for two chunks of this size are tokenized on the calling thread.
+         * @return The tokens of the input, split in statements.
+         */
+        [[nodiscard]] TokenStream tokenizeParallel(std::size_t threadCount = 0, std::size_t minChunkSize = defaultMinChunkSize);
+
+        /**
+         * @brief Lexes on demand up to the next token and consumes it.
+         * @return The next token, or the EOFT token once the input is exhausted.
+         */
+        [[nodiscard]] Token next();
+
+        /**
+         * @brief Lexes on demand up to the next token without consuming it.
+         * @return The next token, valid until the next call on this tokenizer.
+         */
+        [[nodiscard]] const Token &peek();
+
+        /**
+         * @brief Lexes on demand up to the end of the next statement and consumes it.
+         *
+         * Only the statement being handed out is kept in memory, so the input can be parsed while it is lexed.
+         * Tokens already consumed through next() are not part of the returned statement.
+         * @return The tokens of the statement, valid until the next call on this tokenizer, or nullopt at the end.
+         */
+        [[nodiscard]] std::optional<std::span<Token>> nextStatement();
 
     private:
-        std::vector<TokenVec> result;
-        TokenVec tokens;
+        /**
+         * @brief Tokens lexed by a tokenizeParallel() worker, with the line breaks left for the stitching pass.
+         */
+        struct Chunk {
+            TokenStream tokens;                    ///< The tokens of the chunk, in a single open statement.
+            std::vector<std::size_t> lineBreaks;  ///< For each line break, the index of the token that follows it.
+            std::size_t end{0};                    ///< Position where the worker stopped.
+            std::exception_ptr error;              ///< The error that stopped the worker, if any.
+        };
+
+        /**
+         * @brief Constructs a tokenizeParallel() worker over an input already registered in the SourceManager.
+         * @param input The whole input.
+         * @param fileName The name of the file being tokenized.
+         * @param fileId The SourceManager entry of the input.
+         * @param begin The position to start from.
+         */
+        Tokenizer(const std::string_view input, const std::string_view fileName, const FileId fileId, const std::size_t begin) noexcept
+          : _input(input), _filename(fileName), _inputSize(input.size()), _fileId(fileId), position(begin), _chunkMode(true) {}
+
+        TokenStream tokens;          ///< The tokens emitted so far and the statements closed so far.
         std::string_view _input;     ///< The input string to tokenize.
         std::string_view _filename;  ///< The name of the file being tokenized.
         std::size_t _inputSize;      ///< The size of the input string
+        SourceHandle _source;        ///< The SourceManager entry owned by the tokenizer, empty if it shares another's.
+        FileId _fileId;              ///< The SourceManager entry of the input.
         std::size_t position = 0;    ///< Current position in the input string.
-        std::size_t line = 1;        ///< Current line number.
-        std::size_t column = 1;      ///< Current column number.
         std::vector<TokenType> brackets;
         size_t bracketNum = 0;
-        // ArenaAllocator<CodeSourceLocation> _locationAllocator;  ///< Allocator for CodeSourceLocation objects.
+        std::size_t _readIndex = 0;            ///< Index in tokens of the next token handed out by the pull API.
+        std::size_t _statementIndex = 0;       ///< Index in tokens of the next statement handed out by the pull API.
+        bool _finished = false;                ///< Whether the EOFT token has been emitted.
+        Token _eofToken{};                     ///< The EOFT token, handed out again once the input is exhausted.
+        bool _chunkMode = false;               ///< Whether this is a worker that leaves brackets and statements to the caller.
+        std::vector<std::size_t> _lineBreaks;  ///< Line breaks seen by a worker, as indices of the token that follows.
+
+        /**
+         * @brief Drops the tokens and the lexing state, so the input is lexed again from its beginning.
+         */
+        void rewind() noexcept;
+
+        /**
+         * @brief Lexes the whole input from its beginning into tokens.
+         */
+        void lexAll();
+
+        /**
+         * @brief Tokenizes the input after an edit, reusing the previous tokens the edit did not touch.
+         * @param previous The tokens of the input before the edit.
+         * @param edit The edit that turned the previous input into the input of this tokenizer.
+         * @param oldText The input before the edit.
+         * @return The tokens of the input and the statements lexed again.
+         */
+        [[nodiscard]] RelexResult relex(const TokenStream &previous, const SourceEdit &edit, std::string_view oldText);
 
         /**
          * @brief Check if the current position is within the text.
@@ -46,6 +199,44 @@ namespace vnd {
          */
         [[nodiscard]] bool positionIsInText() const noexcept;
 
+        /**
+         * @brief Lexes the token (or the run of operators, or the whitespace) at the current position.
+         */
+        void lexStep();
+
+        /**
+         * @brief Emits the EOFT token and closes the last statement.
+         */
+        void finish();
+
+        /**
+         * @brief Lexes one more step for the pull API, after dropping the tokens already handed out.
+         * @return False if the input was already exhausted.
+         */
+        bool pull();
+
+        /**
+         * @brief Lexes a chunk of the input on a worker tokenizer.
+         * @param begin The position to start from, which must not be inside a token.
+         * @param end The position to stop at; the last token may extend past it.
+         * @return The tokens and the line breaks of the chunk.
+         */
+        [[nodiscard]] Chunk lexChunk(std::size_t begin, std::size_t end) const;
+
+        /**
+         * @brief Appends the tokens of a chunk, closing statements and tracking brackets as tokenize() does.
+         * @param chunk The chunk, which must start where the previous one stopped.
+         */
+        void stitch(const Chunk &chunk);
+
+        /**
+         * @brief Builds a token over a slice of the input.
+         * @param type The type of the token.
+         * @param value The token value, a view into the input.
+         * @return The token.
+         */
+        [[nodiscard]] Token makeToken(TokenType type, std::string_view value) const noexcept;
+
         /**
          * @brief Handles alphabetic characters.
          * @return Token representing alphabetic characters.
@@ -89,33 +280,34 @@ namespace vnd {
         [[nodiscard]] Token handleDot();
 
         /**
-         * @brief Sets the TokenType based on the value.
-         * @param value The value to check.
-         * @param type The TokenType to set.
-         */
-        static void getType(const std::string_view &value, TokenType &type) noexcept;
-
-        /**
-         * @brief Sets TokenType based on the keyword.
+         * @brief Sets TokenType based on the keyword or built-in type.
          * @param value The keyword.
          * @param type TokenType to set.
          */
         static void kewordType(const std::string_view &value, TokenType &type) noexcept;
 
         /**
-         * @brief Handles white space characters.
+         * @brief Handles a line break, closing the current statement outside of brackets (or recording it in a worker).
          */
         void incrementLine() noexcept;
 
-        /**
-         * @brief Handles white space characters.
-         */
-        void handleWhiteSpaceSingle() noexcept;
         /**
          * @brief Handles multiple white space characters.
          */
         void handleWhiteSpace() noexcept;
 
+        /**
+         * @brief Moves to a later position without crossing a line break.
+         * @param newPosition The position to move to.
+         */
+        void advanceTo(const std::size_t newPosition) noexcept;
+
+        /**
+         * @brief Moves to the end of a bulk scan, handling the line breaks it skipped.
+         * @param scan The result of a SimdScanner kernel.
+         */
+        void advanceTo(const ScanResult &scan) noexcept;
+
         /**
          * @brief Finds the start of the current line.
          * @return Position of the start of the current line.
@@ -179,9 +371,9 @@ namespace vnd {
         void extractDigits() noexcept;
 
         /**
-         * @brief Increases position and column.
+         * @brief Increases position.
          */
-        void incPosAndColumn() noexcept;
+        void incPos() noexcept;
 
         /**
          * @brief Extracts exponent from the input.
@@ -189,10 +381,10 @@ namespace vnd {
         void extractExponent() noexcept;
 
         /**
-         * @brief Handles operators.
-         * @return Tokens representing operators.
+         * @brief Handles operators, splitting a run of operator characters into the longest operators first and
+         * appending them straight to the token stream.
          */
-        [[nodiscard]] TokenVec handleOperators();
+        void handleOperators();
 
         /**
          * @brief Extracts variable length operator.
@@ -212,6 +404,12 @@ namespace vnd {
          */
         [[nodiscard]] Token handleBrackets();
 
+        /**
+         * @brief Updates the open brackets after a bracket token.
+         * @param type The token type, ignored if it is not a bracket.
+         */
+        void trackBracket(const TokenType type);
+
         /**
          * @brief Removes a bracket.
          * @param type the bracket token type to close.
@@ -237,13 +435,6 @@ namespace vnd {
          */
         [[nodiscard]] bool inTextAnd(char chr) const noexcept;
 
-        /**
-         * @brief Gets the unsigned character at the specified position.
-         * @param pos The position.
-         * @return The unsigned character.
-         */
-        [[nodiscard]] unsigned char getUnsignedCharAt(const size_t pos) const;
-
         /**
          * @brief Handles strings.
          * @return Token representing strings.
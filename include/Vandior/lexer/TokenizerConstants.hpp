@@ -29,5 +29,169 @@ static inline constexpr std::array<std::pair<std::string_view, TokenType>, 15> k
 }};
 
     // clang-format on
+
+    /**
+     * @brief Compile-time perfect hash from a lexeme to its TokenType.
+     *
+     * The key packs the length with the first and last byte of the lexeme, and a multiply-xorshift hash with a seed
+     * searched at compile time maps every entry to its own bucket, so a lookup costs one hash and one string compare.
+     * @tparam N Number of entries.
+     * @tparam Bits log2 of the number of buckets.
+     */
+    template <std::size_t N, std::size_t Bits> class LexemeHashTable {
+    public:
+        using Entry = std::pair<std::string_view, TokenType>;
+        static inline constexpr std::size_t bucketCount = std::size_t{1} << Bits;
+
+        /**
+         * @brief Builds the table, searching the first seed without collisions.
+         * @param entries The lexemes and their token types; the (length, first, last) keys must be unique.
+         */
+        consteval explicit LexemeHashTable(const std::array<Entry, N> &entries) {
+            for(std::uint32_t candidate = 1; candidate < 4096U; ++candidate) {
+                std::array<bool, bucketCount> used{};
+                bool collision = false;
+                for(const auto &[lexeme, type] : entries) {
+                    const auto index = slot(candidate, lexeme);
+                    if(used[index]) {
+                        collision = true;
+                        break;
+                    }
+                    used[index] = true;
+                }
+                if(!collision) {
+                    seed = candidate;
+                    buckets.fill(Entry{std::string_view{}, TokenType::UNKNOWN});
+                    for(const auto &entry : entries) { buckets[slot(seed, entry.first)] = entry; }
+                    return;
+                }
+            }
+            throw std::logic_error("no collision-free seed for the lexeme table");
+        }
+
+        /**
+         * @brief Looks up a lexeme.
+         * @param lexeme The lexeme to look up.
+         * @param fallback The value returned when the lexeme is not in the table.
+         * @return The TokenType of the lexeme, or fallback.
+         */
+        [[nodiscard]] constexpr TokenType find(const std::string_view lexeme, const TokenType fallback) const noexcept {
+            if(lexeme.empty()) [[unlikely]] { return fallback; }
+            const auto &[key, type] = buckets[slot(seed, lexeme)];
+            return key == lexeme ? type : fallback;
+        }
+
+    private:
+        std::array<Entry, bucketCount> buckets{};
+        std::uint32_t seed = 0;
+
+        [[nodiscard]] static constexpr std::size_t slot(const std::uint32_t hashSeed, const std::string_view lexeme) noexcept {
+            const auto key = C_UI32T(lexeme.size()) | (C_UI32T(C_UC(lexeme.front())) << 8U) | (C_UI32T(C_UC(lexeme.back())) << 16U);
+            // Spread consecutive seeds over the multiplier space, then fold the high bits down once before the final mix.
+            auto mixed = key * ((hashSeed * 0x9E3779B9U) | 1U);
+            mixed ^= mixed >> 15U;
+            return C_ST((mixed * 0x85EBCA6BU) >> (32U - Bits));
+        }
+    };
+
+    /**
+     * @brief Concatenates two lexeme arrays at compile time.
+     */
+    template <std::size_t N, std::size_t M>
+    [[nodiscard]] consteval std::array<std::pair<std::string_view, TokenType>, N + M>
+    concatLexemes(const std::array<std::pair<std::string_view, TokenType>, N> &first,
+                  const std::array<std::pair<std::string_view, TokenType>, M> &second) noexcept {
+        std::array<std::pair<std::string_view, TokenType>, N + M> result{};
+        std::ranges::copy(first, result.begin());
+        std::ranges::copy(second, result.begin() + N);
+        return result;
+    }
+
+    /// Keywords and built-in types, looked up once per identifier.
+    static inline constexpr LexemeHashTable<keywordArray.size() + typeArray.size(), 7> keywordTypeTable{
+        concatLexemes(keywordArray, typeArray)};
+    /// Two-character operators, looked up once per operator pair.
+    static inline constexpr LexemeHashTable<multiCharOperators.size(), 5> multiCharOperatorTable{multiCharOperators};
+
+    /**
+     * @brief Lexical class of a single input byte, used to pick the tokenizer handler without an if/else chain.
+     */
+    enum class CharClass : std::uint8_t {
+        Unknown,     ///< Byte that cannot start a token.
+        Alpha,       ///< [A-Za-z], start of identifiers, keywords and types.
+        Digit,       ///< [0-9], start of numbers.
+        Underscore,  ///< '_', start of identifiers.
+        Hash,        ///< '#', start of hexadecimal or octal numbers.
+        Space,       ///< Whitespace, including '\n' and '\r'.
+        Slash,       ///< '/', either a comment or the divide operator.
+        Operator,    ///< One of the operator characters other than '/'.
+        Dot,         ///< '.', member access or a leading-dot number.
+        Bracket,     ///< One of ()[]{}.
+        Apostrophe,  ///< '\'', start of a char literal.
+        Quotation,   ///< '"', start of a string literal.
+        CommaColon   ///< ',' or ':'.
+    };
+
+    /**
+     * @brief Bit flags describing the byte classes tested by the tokenizer scanning loops.
+     */
+    enum CharTrait : std::uint8_t {
+        TRAIT_NONE = 0U,
+        TRAIT_IDENT = 1U << 0U,     ///< [A-Za-z0-9_]
+        TRAIT_DIGIT = 1U << 1U,     ///< [0-9]
+        TRAIT_HEX = 1U << 2U,       ///< [0-9A-Fa-f]
+        TRAIT_OCTAL = 1U << 3U,     ///< [0-7]
+        TRAIT_SPACE = 1U << 4U,     ///< ' ', '\t', '\n', '\v', '\f', '\r'
+        TRAIT_OPERATOR = 1U << 5U,  ///< Characters that can be part of an operator run.
+        TRAIT_NEWLINE = 1U << 6U    ///< '\n' or '\r'
+    };
+
+    /**
+     * @brief Entry of the character table: the dispatch class of the byte and its trait bits.
+     */
+    struct CharInfo {
+        CharClass charClass = CharClass::Unknown;
+        std::uint8_t traits = TRAIT_NONE;
+    };
+
+    static inline constexpr std::array<char, 12> operatorChars = {starcr, slashcr, '=', '<', '>', '!', '|', '&', '+', '-', '^', '%'};
+    static inline constexpr std::array<char, 6> bracketChars = {'(', ')', '[', ']', '{', '}'};
+    static inline constexpr std::array<char, 6> spaceChars = {' ', CTAB, NL, '\v', '\f', CR};
+
+    /**
+     * @brief Builds the 256-entry character table from the operator, bracket and punctuation definitions.
+     * @return The character table indexed by unsigned byte value.
+     */
+    [[nodiscard]] consteval std::array<CharInfo, 256> makeCharTable() noexcept {
+        std::array<CharInfo, 256> table{};
+        const auto set = [&table](const char cha, const CharClass charClass, const std::uint8_t traits = TRAIT_NONE) {
+            auto &info = table[C_UC(cha)];
+            info.charClass = charClass;
+            info.traits = C_UI8T(info.traits | traits);
+        };
+        for(char cha = 'a'; cha <= 'z'; ++cha) { set(cha, CharClass::Alpha, TRAIT_IDENT); }
+        for(char cha = 'A'; cha <= 'Z'; ++cha) { set(cha, CharClass::Alpha, TRAIT_IDENT); }
+        for(char cha = 'a'; cha <= 'f'; ++cha) { set(cha, CharClass::Alpha, TRAIT_HEX); }
+        for(char cha = 'A'; cha <= 'F'; ++cha) { set(cha, CharClass::Alpha, TRAIT_HEX); }
+        for(char cha = zerocr; cha <= '9'; ++cha) {
+            set(cha, CharClass::Digit, C_UI8T(TRAIT_IDENT | TRAIT_DIGIT | TRAIT_HEX | (cha <= sevencr ? TRAIT_OCTAL : TRAIT_NONE)));
+        }
+        set(underscore, CharClass::Underscore, TRAIT_IDENT);
+        set('#', CharClass::Hash);
+        for(const char cha : spaceChars) { set(cha, CharClass::Space, TRAIT_SPACE); }
+        set(NL, CharClass::Space, TRAIT_NEWLINE);
+        set(CR, CharClass::Space, TRAIT_NEWLINE);
+        for(const char cha : operatorChars) { set(cha, CharClass::Operator, TRAIT_OPERATOR); }
+        set(slashcr, CharClass::Slash);
+        set(PNT, CharClass::Dot);
+        for(const char cha : bracketChars) { set(cha, CharClass::Bracket); }
+        set('\'', CharClass::Apostrophe);
+        set('"', CharClass::Quotation);
+        set(commacr, CharClass::CommaColon);
+        set(coloncr, CharClass::CommaColon);
+        return table;
+    }
+
+    static inline constexpr auto charTable = makeCharTable();
 }  // namespace vnd
    // NOLINTEND(*-include-cleaner)
\ No newline at end of file
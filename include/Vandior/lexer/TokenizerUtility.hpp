@@ -2,6 +2,7 @@
 #pragma once
 #include "../headers.hpp"
 #include "Vandior/lexer/TokenType.hpp"
+#include "Vandior/lexer/TokenizerConstants.hpp"
 namespace vnd {
 
     /**
@@ -9,6 +10,23 @@ namespace vnd {
      */
     class TokenizerUtility {
     public:
+        /**
+         * @brief Get the dispatch class of the character from the character table.
+         * @param cha The character to classify.
+         * @return The CharClass of the character.
+         */
+        [[nodiscard]] static constexpr CharClass getCharClass(const char cha) noexcept { return charTable[C_UC(cha)].charClass; }
+
+        /**
+         * @brief Check if the character has any of the given trait bits in the character table.
+         * @param cha The character to check.
+         * @param trait The CharTrait bits to test.
+         * @return True if at least one of the bits is set, false otherwise.
+         */
+        [[nodiscard]] static constexpr bool hasTrait(const char cha, const std::uint8_t trait) noexcept {
+            return (charTable[C_UC(cha)].traits & trait) != 0U;
+        }
+
         /**
          * @brief Check if the character is an operator.
          * @param aChar The character to check.
@@ -5,7 +5,9 @@
 #pragma once
 
 #include "../headers.hpp"
+#include "ASTVisitor.hpp"
 #include "BinaryExpressionNode.hpp"
+#include "DeclarationNode.hpp"
 #include "IndexNode.hpp"
 #include "LiteralNode.hpp"
 #include "NullptrNode.hpp"
@@ -23,6 +25,16 @@ static inline constexpr auto PRETTYPRINT_AST_FORMAT2 = "{}, val: {})";
 static inline constexpr auto PRETTYPRINT_AST_FORMAT3 = "{}_{}, val: {})";
 static inline constexpr auto PRETTYPRINT_AST_NULLPTR = "{} NULLPTR)";
 
+/**
+ * @brief A node waiting to be printed by prettyPrint.
+ */
+struct PrettyPrintItem {
+    const vnd::ASTNode *node;  ///< The node.
+    bool isLast;               ///< Whether the node is the last child of its parent.
+    std::string_view lorf;     ///< The label of the node under its parent.
+    std::size_t depth{0};      ///< The depth of the node under the printed root, filled in by prettyPrint.
+};
+
 /**
  * @brief Prints the parent node of the AST.
  *
@@ -36,48 +48,57 @@ void printParentNode(const vnd::ASTNode &node, const std::string &indentmark);
  *
  * @param node The binary expression node to be printed.
  * @param imarknode The indentation mark for the node.
- * @param newindent The new indentation for the next level.
+ * @param children Receives the children to print under the node, in order.
  */
-void printBinaryNode(const vnd::BinaryExpressionNode &node, const std::string &imarknode, const std::string &newindent);
+void printBinaryNode(const vnd::BinaryExpressionNode &node, const std::string &imarknode, std::vector<PrettyPrintItem> &children);
 
 /**
  * @brief Prints a unary expression node of the AST.
  *
  * @param node The unary expression node to be printed.
  * @param imarknode The indentation mark for the node.
- * @param newindent The new indentation for the next level.
+ * @param children Receives the children to print under the node, in order.
  */
-void printUnaryNode(const vnd::UnaryExpressionNode &node, const std::string &imarknode, const std::string &newindent);
+void printUnaryNode(const vnd::UnaryExpressionNode &node, const std::string &imarknode, std::vector<PrettyPrintItem> &children);
 
 /**
  * @brief Prints a variable node of the AST.
  *
  * @param node The variable node to be printed.
  * @param imarknode The indentation mark for the node.
- * @param newindent The new indentation for the next level.
+ * @param children Receives the children to print under the node, in order.
  */
-void printVariableNode(const vnd::VariableNode &node, const std::string &imarknode, const std::string &newindent);
+void printVariableNode(const vnd::VariableNode &node, const std::string &imarknode, std::vector<PrettyPrintItem> &children);
 
 /**
  * @brief Prints an index node of the AST.
  *
  * @param node The index node to be printed.
  * @param indentmark The indentation mark for formatting.
- * @param newindent The new indentation for the next level.
+ * @param children Receives the children to print under the node, in order.
  */
-void printIndexNode(const vnd::IndexNode &node, const std::string &indentmark, const std::string &newindent);
+void printIndexNode(const vnd::IndexNode &node, const std::string &indentmark, std::vector<PrettyPrintItem> &children);
 
 /**
  * @brief Prints an array node of the AST.
  *
  * @param node The array node to be printed.
  * @param indentmark The indentation mark for formatting.
- * @param newindent The new indentation for the next level.
+ * @param children Receives the children to print under the node, in order.
+ */
+void printArrayNode(const vnd::ArrayNode &node, const std::string &indentmark, std::vector<PrettyPrintItem> &children);
+
+/**
+ * @brief Prints a declaration node of the AST.
+ *
+ * @param node The declaration node to be printed.
+ * @param imarknode The indentation mark for the node.
+ * @param children Receives the children to print under the node, in order.
  */
-void printArrayNode(const vnd::ArrayNode &node, const std::string &indentmark, const std::string &newindent);
+void printDeclarationNode(const vnd::DeclarationNode &node, const std::string &imarknode, std::vector<PrettyPrintItem> &children);
 
 /**
- * @brief Recursively prints the structure of an AST (Abstract Syntax Tree).
+ * @brief Prints the structure of an AST (Abstract Syntax Tree).
  *
  * This function is designed to traverse and print the structure of an AST, represented by instances
  * of the `vnd::ASTNode` class and its derived classes. The printed structure provides information
@@ -85,18 +106,16 @@ void printArrayNode(const vnd::ArrayNode &node, const std::string &indentmark, c
  * the tree (e.g., left or right subtree).
  *
  * @param node The root node of the AST or subtree to be printed.
- * @param indent string specifying the indentation for each level of the tree. This argument
- *               is used internally during recursion to maintain the visual hierarchy.
+ * @param indent string prefixed to the indentation of every level of the tree.
  *               Defaults to an empty string.
  * @param isLast An optional Boolean value indicating whether the current node is the last node in
- *               its subtree. Used internally during recursion to determine the formatting.
- *               Defaults to `true`.
+ *               its subtree, which determines the formatting. Defaults to `true`.
  * @param lorf An optional string specifying whether the node is in the left or right subtree of its
  *             parent node. It can take the values "LEFT" or "RIGHT". Defaults to an empty string.
  *
  * @note The function uses a series of conditional statements to determine the type of the AST node
- * and prints the appropriate information depending on the node type. It also uses recursion to
- * traverse the entire AST structure.
+ * and prints the appropriate information depending on the node type. It walks the AST with an explicit
+ * stack, so the depth of the tree is bounded by memory and not by the call stack.
  */
 void prettyPrint(const vnd::ASTNode &node, const std::string &indent = "", bool isLast = true, const std::string &lorf = "");
 
@@ -9,6 +9,66 @@
 
 namespace vnd {
 
+    /**
+     * @brief Concrete class of an AST node: its NodeType, with numbers split by NumberNodeType.
+     *
+     * Stored in the node, so visit() can pick the class with a single switch instead of trying casts.
+     */
+    enum class NodeKind : std::uint8_t {
+        BinaryExpression,
+        UnaryExpression,
+        Variable,
+        Integer,
+        Float,
+        Double,
+        ImaginaryFloat,
+        Imaginary,
+        Boolean,
+        Char,
+        String,
+        Nullptr,
+        Type,
+        Index,
+        Array,
+        Declaration,
+        Statement,
+        Unknown
+    };
+
+    /**
+     * @brief Deleter of the links between AST nodes.
+     *
+     * Nodes allocated on their own are deleted with their parent; nodes that live in an Arena are left alone and go
+     * away all at once when the arena is released, without walking the tree.
+     */
+    struct NodeDeleter {
+        bool owned = true;  ///< Whether the node was allocated on its own and must be deleted.
+
+        constexpr NodeDeleter() noexcept = default;
+        constexpr explicit NodeDeleter(const bool owned_) noexcept : owned(owned_) {}
+        template <typename U> constexpr explicit(false) NodeDeleter(const std::default_delete<U> & /*deleter*/) noexcept {}
+
+        template <typename T> void operator()(T *node) const noexcept {
+            if(owned) { delete node; }  // NOLINT(*-owning-memory)
+        }
+    };
+
+    /**
+     * @brief Link from an AST node (or a statement) to a child node.
+     * @tparam T The type of the child.
+     */
+    template <typename T> using NodePtr = std::unique_ptr<T, NodeDeleter>;
+
+    /**
+     * @brief Whether a member of a node owns nothing, as nodes built in an Arena are never destroyed.
+     *
+     * Links to other nodes qualify, since in an arena they do not own their child; any other member has to be
+     * trivially destructible. Every node class asserts it on its members.
+     * @tparam T The type of the member.
+     */
+    template <typename T> inline constexpr bool ownsNoResource = std::is_trivially_destructible_v<T>;
+    template <typename T> inline constexpr bool ownsNoResource<NodePtr<T>> = true;
+
     /**
      * @brief Base class for Abstract Syntax Tree (AST) nodes.
      *
@@ -22,6 +82,13 @@ namespace vnd {
          */
         [[nodiscard]] explicit ASTNode(const Token &token) noexcept : m_token(token), parent(nullptr) {}
 
+        /**
+         * @brief Constructor for the node classes known to visit().
+         * @param token The token associated with this AST node.
+         * @param kind The concrete class of the node.
+         */
+        [[nodiscard]] ASTNode(const Token &token, const NodeKind kind) noexcept : m_token(token), parent(nullptr), m_kind(kind) {}
+
         /**
          * @brief Destructor for ASTNode.
          */
@@ -33,6 +100,12 @@ namespace vnd {
          */
         [[nodiscard]] virtual NodeType getType() const = 0;
 
+        /**
+         * @brief Gets the concrete class of the node, without a virtual call.
+         * @return NodeKind enumeration value, NodeKind::Unknown for classes visit() does not know.
+         */
+        [[nodiscard]] NodeKind getKind() const noexcept { return m_kind; }
+
         /**
          * @brief Returns a string representation of the AST node.
          * @return String representation of the AST node.
@@ -103,6 +176,12 @@ namespace vnd {
          */
         [[nodiscard]] const Token &get_token() const noexcept { return m_token; }
 
+        /**
+         * @brief Moves the node and its children to another source after an edit that did not touch them.
+         * @param shift The source change.
+         */
+        virtual void rebase(const SourceShift &shift) { m_token.rebase(shift); }
+
         /**
          * @brief Get the parent node of the current ASTNode.
          *
@@ -130,7 +209,10 @@ namespace vnd {
 
     private:
         Token m_token;
-        ASTNode *parent;  // Parent node reference
+        ASTNode *parent;                     // Parent node reference
+        NodeKind m_kind{NodeKind::Unknown};  // Concrete class of the node
+
+        static_assert(ownsNoResource<decltype(m_token)> && ownsNoResource<decltype(parent)> && ownsNoResource<decltype(m_kind)>);
     };
 
 }  // namespace vnd
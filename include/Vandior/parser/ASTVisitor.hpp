@@ -0,0 +1,90 @@
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "ArrayNode.hpp"
+#include "BinaryExpressionNode.hpp"
+#include "DeclarationNode.hpp"
+#include "IndexNode.hpp"
+#include "LiteralNode.hpp"
+#include "NullptrNode.hpp"
+#include "NumberNode.hpp"
+#include "Statement.hpp"
+#include "TypeNode.hpp"
+#include "UnaryExpressionNode.hpp"
+#include "VariableNode.hpp"
+
+namespace vnd {
+
+    /**
+     * @brief Builds a visitor out of lambdas, one per node class.
+     * @tparam Ts The lambdas.
+     */
+    template <typename... Ts> struct Overloaded : Ts... {
+        using Ts::operator()...;
+    };
+
+    /**
+     * @brief Calls a visitor with a node cast to its concrete class.
+     *
+     * The class comes from the NodeKind stored in the node, so the dispatch is one switch, compiled to a jump
+     * table, with no RTTI and no virtual call.
+     * @param node The node to visit.
+     * @param visitor A callable taking every node class, with an overload for ASTNode called for NodeKind::Unknown.
+     * @return What the visitor returns; every overload must return the same type.
+     */
+    template <typename Visitor> auto visit(const ASTNode &node, Visitor &&visitor) -> std::invoke_result_t<Visitor &, const ASTNode &> {
+        switch(node.getKind()) {
+            using enum NodeKind;
+        case BinaryExpression:
+            return visitor(static_cast<const BinaryExpressionNode &>(node));
+        case UnaryExpression:
+            return visitor(static_cast<const UnaryExpressionNode &>(node));
+        case Variable:
+            return visitor(static_cast<const VariableNode &>(node));
+        case Integer:
+            return visitor(static_cast<const VND_NUM_INT &>(node));
+        case Float:
+            return visitor(static_cast<const VND_NUM_FLOAT &>(node));
+        case Double:
+            return visitor(static_cast<const VND_NUM_DOUBLE &>(node));
+        case ImaginaryFloat:
+            return visitor(static_cast<const VND_NUM_CFLOAT &>(node));
+        case Imaginary:
+            return visitor(static_cast<const VND_NUM_CDOUBLE &>(node));
+        case Boolean:
+            return visitor(static_cast<const LiteralNode<bool> &>(node));
+        case Char:
+            return visitor(static_cast<const LiteralNode<char> &>(node));
+        case String:
+            return visitor(static_cast<const LiteralNode<std::string_view> &>(node));
+        case Nullptr:
+            return visitor(static_cast<const NullptrNode &>(node));
+        case Type:
+            return visitor(static_cast<const TypeNode &>(node));
+        case Index:
+            return visitor(static_cast<const IndexNode &>(node));
+        case Array:
+            return visitor(static_cast<const ArrayNode &>(node));
+        case Declaration:
+            return visitor(static_cast<const DeclarationNode &>(node));
+        case Statement:
+            return visitor(static_cast<const vnd::Statement &>(node));
+        [[unlikely]] case Unknown:
+        [[unlikely]] default:
+            return visitor(node);
+        }
+    }
+
+    /**
+     * @brief Casts a node to a class if it is that class, through its NodeKind.
+     * @tparam T The class, one of those visit() dispatches to.
+     * @param node The node.
+     * @return The node as a T, or nullptr if it is not a T.
+     */
+    template <typename T> [[nodiscard]] const T *node_cast(const ASTNode &node) noexcept {
+        return visit(node, Overloaded{[](const T &match) -> const T * { return &match; }, [](const auto &) -> const T * { return nullptr; }});
+    }
+
+}  // namespace vnd
+
+// NOLINTEND(*-include-cleaner)
@@ -18,7 +18,7 @@ namespace vnd {
          * @param elements The elements of the array.
          * @param token The token correspondent to the node.
          */
-        [[nodiscard]] ArrayNode(std::unique_ptr<ASTNode> elements, const Token &token) noexcept;
+        [[nodiscard]] ArrayNode(NodePtr<ASTNode> elements, const Token &token) noexcept;
 
         /**
          * @brief Gets the type of the AST node.
@@ -42,7 +42,13 @@ namespace vnd {
          * @brief Gets the elements of the node.
          * @return The elements of the node.
          */
-        [[nodiscard]] const std::unique_ptr<ASTNode> &get_elements() const noexcept;
+        [[nodiscard]] const NodePtr<ASTNode> &get_elements() const noexcept;
+
+        /**
+         * @brief Moves the node and its children to another source after an edit that did not touch them.
+         * @param shift The source change.
+         */
+        void rebase(const SourceShift &shift) override;
 
         /**
          * @brief Swaps the contents of two LiteralNode objects.
@@ -56,7 +62,9 @@ namespace vnd {
         }
 
     private:
-        std::unique_ptr<ASTNode> m_elements;  ///< The elements child of the array.
+        NodePtr<ASTNode> m_elements;  ///< The elements child of the array.
+
+        static_assert(ownsNoResource<decltype(m_elements)>);
     };
 
 }  // namespace vnd
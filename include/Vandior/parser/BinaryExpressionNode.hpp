@@ -22,8 +22,8 @@ namespace vnd {
          * @param _left Left operand.
          * @param _right Right operand.
          */
-        [[nodiscard]] BinaryExpressionNode(std::string_view _op, const Token &op_Token, std::unique_ptr<ASTNode> _left,
-                                           std::unique_ptr<ASTNode> _right) noexcept;
+        [[nodiscard]] BinaryExpressionNode(std::string_view _op, const Token &op_Token, NodePtr<ASTNode> _left,
+                                           NodePtr<ASTNode> _right) noexcept;
 
         /**
          * @brief Constructor for BinaryExpressionNode.
@@ -31,7 +31,7 @@ namespace vnd {
          * @param _left Left operand.
          * @param _right Right operand.
          */
-        [[nodiscard]] BinaryExpressionNode(const Token &op_Token, std::unique_ptr<ASTNode> _left, std::unique_ptr<ASTNode> _right) noexcept;
+        [[nodiscard]] BinaryExpressionNode(const Token &op_Token, NodePtr<ASTNode> _left, NodePtr<ASTNode> _right) noexcept;
 
         /**
          * @brief Gets the type of the AST node.
@@ -61,16 +61,34 @@ namespace vnd {
          * @brief Gets the left operand of the binary expression.
          * @return A constant reference to the unique pointer of the left operand.
          */
-        [[nodiscard]] const std::unique_ptr<ASTNode> &getLeft() const noexcept;
+        [[nodiscard]] const NodePtr<ASTNode> &getLeft() const noexcept;
 
         /**
          * @brief Gets the right operand of the binary expression.
          * @return A constant reference to the unique pointer of the right operand.
          */
-        [[nodiscard]] const std::unique_ptr<ASTNode> &getRight() const noexcept;
+        [[nodiscard]] const NodePtr<ASTNode> &getRight() const noexcept;
         [[nodiscard]] const ASTNode &getLeftr() const noexcept;
         [[nodiscard]] const ASTNode &getRightr() const noexcept;
 
+        /**
+         * @brief Takes the left operand away from the binary expression, which is left without it.
+         * @return The left operand.
+         */
+        [[nodiscard]] NodePtr<ASTNode> takeLeft() noexcept;
+
+        /**
+         * @brief Takes the right operand away from the binary expression, which is left without it.
+         * @return The right operand.
+         */
+        [[nodiscard]] NodePtr<ASTNode> takeRight() noexcept;
+
+        /**
+         * @brief Moves the node and its children to another source after an edit that did not touch them.
+         * @param shift The source change.
+         */
+        void rebase(const SourceShift &shift) override;
+
         friend void swap(BinaryExpressionNode &lhs, BinaryExpressionNode &rhs) noexcept {
             using std::swap;
             swap(static_cast<ASTNode &>(lhs), static_cast<ASTNode &>(rhs));
@@ -81,8 +99,10 @@ namespace vnd {
 
     private:
         std::string_view op;             ///< The operator for the binary expression.
-        std::unique_ptr<ASTNode> left;   ///< The left operand.
-        std::unique_ptr<ASTNode> right;  ///< The right operand.
+        NodePtr<ASTNode> left;   ///< The left operand.
+        NodePtr<ASTNode> right;  ///< The right operand.
+
+        static_assert(ownsNoResource<decltype(op)> && ownsNoResource<decltype(left)> && ownsNoResource<decltype(right)>);
     };
 }  // namespace vnd
 
@@ -33,6 +33,8 @@ DISABLE_WARNINGS_PUSH(4061)
         return "IDX";
     case Array:
         return "ARR";
+    case Declaration:
+        return "DECL";
     default:
         return "UNKNOWN";
     }
@@ -0,0 +1,64 @@
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "FlatAST.hpp"
+#include "Parser.hpp"
+
+namespace vnd {
+
+    /**
+     * @brief A source file together with its tokens and its AST, each computed once and shared by every stage.
+     *
+     * The unit owns the source buffer and the only Tokenizer over it, so the file is registered in the SourceManager,
+     * lexed and parsed once however many consumers (CLI, Parser, Transpiler) read it. Tokens and statements point into
+     * the buffer, so the unit can be neither copied nor moved.
+     */
+    class CompilationUnit {
+    public:
+        /**
+         * @brief Constructs a unit; nothing is lexed until the tokens or the statements are asked for.
+         * @param source The source code.
+         * @param fileName The name of the source file.
+         */
+        CompilationUnit(std::string source, std::string fileName);
+
+        CompilationUnit(const CompilationUnit &other) = delete;
+        CompilationUnit(CompilationUnit &&other) = delete;
+        CompilationUnit &operator=(const CompilationUnit &other) = delete;
+        CompilationUnit &operator=(CompilationUnit &&other) = delete;
+        ~CompilationUnit() = default;
+
+        [[nodiscard]] std::string_view source() const noexcept { return _source; }
+        [[nodiscard]] std::string_view fileName() const noexcept { return _fileName; }
+
+        /**
+         * @brief Gets the tokens of the source, lexing it on the first call.
+         * @return The tokens.
+         */
+        [[nodiscard]] const TokenStream &tokens();
+
+        /**
+         * @brief Gets the statements of the source, parsing the tokens on the first call.
+         * @return The statements.
+         */
+        [[nodiscard]] const std::vector<Statement> &statements();
+
+        /**
+         * @brief Gets the flat form of the statements, converting them on the first call.
+         * @return The flat AST.
+         */
+        [[nodiscard]] const FlatAST &flatAST();
+
+    private:
+        std::string _source;                                ///< The source code.
+        std::string _fileName;                              ///< The name of the source file.
+        Arena _arena;                                       ///< The AST nodes, freed at once so deep trees unwind without recursion.
+        Parser _parser;                                     ///< The parser, and through it the tokenizer, of the source.
+        std::optional<TokenStream> _tokens;                 ///< The tokens, once lexed.
+        std::optional<std::vector<Statement>> _statements;  ///< The statements, once parsed.
+        std::optional<FlatAST> _flatAST;                    ///< The flat AST, once converted.
+    };
+
+}  // namespace vnd
+
+// NOLINTEND(*-include-cleaner)
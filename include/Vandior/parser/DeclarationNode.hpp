@@ -0,0 +1,93 @@
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "ASTNode.hpp"
+
+DISABLE_WARNINGS_PUSH(4625 4626 26445)
+namespace vnd {
+
+    /**
+     * @brief Node class representing the declaration of a var, val or const statement.
+     *
+     * `var a, b: i32 = 1, 2` declares the names `a, b` of type `i32` initialized with `1, 2`; several names or
+     * initializers are linked by ',' binary expressions, like call arguments and array elements.
+     */
+    class DeclarationNode : public ASTNode {
+    public:
+        /**
+         * @brief Constructs a DeclarationNode.
+         * @param token The keyword token of the statement.
+         * @param names The declared names.
+         * @param type The declared type, or nullptr when it is inferred.
+         * @param initializers The initial values, or nullptr.
+         */
+        [[nodiscard]] DeclarationNode(const Token &token, NodePtr<ASTNode> names, NodePtr<ASTNode> type,
+                                      NodePtr<ASTNode> initializers) noexcept;
+
+        /**
+         * @brief Gets the type of the AST node.
+         * @return NodeType enumeration value.
+         */
+        [[nodiscard]] NodeType getType() const noexcept override;
+
+        /**
+         * @brief Returns a string representation of the AST node.
+         * @return String representation of the AST node.
+         */
+        [[nodiscard]] std::string print() const override;
+
+        /**
+         * @brief Returns a compact string representation of the AST node for compilation purposes.
+         * @return Compact string representation of the AST node.
+         */
+        [[nodiscard]] std::string comp_print() const override;
+
+        /**
+         * @brief Gets the declared names.
+         * @return The names.
+         */
+        [[nodiscard]] const NodePtr<ASTNode> &get_names() const noexcept;
+
+        /**
+         * @brief Gets the declared type.
+         * @return The type, or nullptr when it is inferred.
+         */
+        [[nodiscard]] const NodePtr<ASTNode> &get_declared_type() const noexcept;
+
+        /**
+         * @brief Gets the initial values.
+         * @return The initializers, or nullptr.
+         */
+        [[nodiscard]] const NodePtr<ASTNode> &get_initializers() const noexcept;
+
+        /**
+         * @brief Moves the node and its children to another source after an edit that did not touch them.
+         * @param shift The source change.
+         */
+        void rebase(const SourceShift &shift) override;
+
+        /**
+         * @brief Swaps the contents of two DeclarationNode objects.
+         * @param lhs The first DeclarationNode.
+         * @param rhs The second DeclarationNode.
+         */
+        friend void swap(DeclarationNode &lhs, DeclarationNode &rhs) noexcept {
+            using std::swap;
+            swap(static_cast<ASTNode &>(lhs), static_cast<ASTNode &>(rhs));
+            swap(lhs.m_names, rhs.m_names);
+            swap(lhs.m_type, rhs.m_type);
+            swap(lhs.m_initializers, rhs.m_initializers);
+        }
+
+    private:
+        NodePtr<ASTNode> m_names;         ///< The declared names.
+        NodePtr<ASTNode> m_type;          ///< The declared type.
+        NodePtr<ASTNode> m_initializers;  ///< The initial values.
+
+        static_assert(ownsNoResource<decltype(m_names)> && ownsNoResource<decltype(m_type)> && ownsNoResource<decltype(m_initializers)>);
+    };
+
+}  // namespace vnd
+DISABLE_WARNINGS_POP()
+
+// NOLINTEND(*-include-cleaner)
@@ -0,0 +1,167 @@
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "ASTVisitor.hpp"
+
+namespace vnd {
+
+    /// Index of a node in a FlatAST.
+    using NodeId = std::uint32_t;
+
+    /// NodeId of a missing node.
+    inline constexpr NodeId noNode = std::numeric_limits<NodeId>::max();
+
+    /**
+     * @brief Place of a node under its parent; optional children leave gaps, so a child is found by its role.
+     */
+    enum class NodeRole : std::uint8_t {
+        Root,          ///< Root of a statement.
+        Left,          ///< Left operand of a binary expression.
+        Right,         ///< Right operand of a binary expression.
+        Operand,       ///< Operand of a unary expression.
+        Index,         ///< Index of a variable, a type or another index.
+        Call,          ///< Arguments of a call.
+        Elements,      ///< Elements of an index or an array.
+        Array,         ///< Array elements given after an index.
+        Names,         ///< Names of a declaration.
+        DeclaredType,  ///< Type of a declaration.
+        Initializers   ///< Initial values of a declaration.
+    };
+
+    /// Value of a number node.
+    using NumberValue = std::variant<int, float, double, std::complex<float>, std::complex<double>>;
+
+    /**
+     * @brief AST stored as parallel arrays indexed by NodeId instead of a graph of polymorphic nodes.
+     *
+     * Every node has a kind, the index of its token, its role and first-child/next-sibling links, plus a payload
+     * whose meaning depends on the kind. Nodes are numbered in pre-order, so walking a statement reads the arrays
+     * front to back.
+     */
+    class FlatAST {
+    public:
+        /**
+         * @brief Builds the flat form of parsed statements.
+         * @param statements The statements, as returned by Parser::parse().
+         * @return The flat AST.
+         */
+        [[nodiscard]] static FlatAST fromStatements(std::span<const Statement> statements);
+
+        /**
+         * @brief Gets the number of nodes.
+         * @return The number of nodes.
+         */
+        [[nodiscard]] std::size_t size() const noexcept { return _kinds.size(); }
+
+        [[nodiscard]] NodeKind kind(const NodeId node) const noexcept { return _kinds[node]; }
+        [[nodiscard]] NodeRole role(const NodeId node) const noexcept { return _roles[node]; }
+        [[nodiscard]] NodeId firstChild(const NodeId node) const noexcept { return _firstChild[node]; }
+        [[nodiscard]] NodeId nextSibling(const NodeId node) const noexcept { return _nextSibling[node]; }
+        [[nodiscard]] const Token &token(const NodeId node) const noexcept { return _tokens[_tokenIndex[node]]; }
+
+        /**
+         * @brief Finds a child by its role.
+         * @param node The parent.
+         * @param role The role of the child.
+         * @return The child, or noNode.
+         */
+        [[nodiscard]] NodeId child(const NodeId node, const NodeRole role) const noexcept {
+            for(auto current = _firstChild[node]; current != noNode; current = _nextSibling[current]) {
+                if(_roles[current] == role) { return current; }
+            }
+            return noNode;
+        }
+
+        /**
+         * @brief Gets the text of a node: the operator, the variable name, the type name or the string literal.
+         * @param node The node.
+         * @return The text, empty for the other kinds.
+         */
+        [[nodiscard]] std::string_view text(const NodeId node) const noexcept;
+
+        /**
+         * @brief Checks whether a variable node is a call.
+         * @param node The variable node.
+         * @return True if the variable is called.
+         */
+        [[nodiscard]] bool isCall(const NodeId node) const noexcept { return _calls[node]; }
+
+        /**
+         * @brief Gets the value of a boolean literal node.
+         * @param node The boolean node.
+         * @return The value.
+         */
+        [[nodiscard]] bool boolean(const NodeId node) const noexcept { return _payload[node] != 0; }
+
+        /**
+         * @brief Gets the value of a char literal node.
+         * @param node The char node.
+         * @return The value.
+         */
+        [[nodiscard]] char character(const NodeId node) const noexcept { return static_cast<char>(_payload[node]); }
+
+        /**
+         * @brief Gets the value of a number node.
+         * @param node The number node.
+         * @return The value.
+         */
+        [[nodiscard]] const NumberValue &number(const NodeId node) const noexcept { return _numbers[_payload[node]]; }
+
+        /**
+         * @brief Gets the number of statements.
+         * @return The number of statements.
+         */
+        [[nodiscard]] std::size_t statementCount() const noexcept { return _statementRoots.size(); }
+
+        [[nodiscard]] const Token &statementToken(const std::size_t statement) const noexcept {
+            return _tokens[_statementTokens[statement]];
+        }
+        [[nodiscard]] NodeId statementRoot(const std::size_t statement) const noexcept { return _statementRoots[statement]; }
+        [[nodiscard]] const StrViewVec &funData(const std::size_t statement) const noexcept { return _funData[statement]; }
+
+    private:
+        /**
+         * @brief A tree node waiting to be added, with the place it takes in the flat form.
+         */
+        struct PendingNode {
+            const ASTNode *node;  ///< The tree node.
+            NodeRole role;        ///< The role of the node under its parent.
+            NodeId parent;        ///< The parent, already added, or noNode for the root.
+        };
+
+        /**
+         * @brief Appends a tree node and its subtree, walking it with an explicit stack so that the depth of the tree
+         * is bounded by memory and not by the call stack.
+         * @param root The tree node.
+         * @param role The role of the node under its parent.
+         * @return The id of the node.
+         */
+        NodeId add(const ASTNode &root, NodeRole role);
+
+        /**
+         * @brief Appends a single tree node, without linking it, and queues its children.
+         * @param node The tree node.
+         * @param role The role of the node under its parent.
+         * @param pending The nodes still to add; the children of node are pushed on top, the first one last.
+         * @return The id of the node.
+         */
+        NodeId addNode(const ASTNode &node, NodeRole role, std::vector<PendingNode> &pending);
+
+        std::vector<NodeKind> _kinds;             ///< Kind of each node.
+        std::vector<std::uint32_t> _tokenIndex;   ///< Index in _tokens of the token of each node.
+        std::vector<NodeRole> _roles;             ///< Role of each node under its parent.
+        std::vector<NodeId> _firstChild;          ///< First child of each node.
+        std::vector<NodeId> _nextSibling;         ///< Next sibling of each node.
+        std::vector<std::uint32_t> _payload;      ///< Index in _texts or _numbers, or literal value.
+        std::vector<bool> _calls;                 ///< Whether each node is a variable called as a function.
+        std::vector<Token> _tokens;               ///< The tokens of the nodes and of the statements.
+        std::vector<std::string_view> _texts;     ///< Operators, names, type names and string literals.
+        std::vector<NumberValue> _numbers;        ///< Values of the number nodes.
+        std::vector<std::uint32_t> _statementTokens;  ///< Index in _tokens of the keyword token of each statement.
+        std::vector<NodeId> _statementRoots;          ///< Root of each statement, or noNode.
+        std::vector<StrViewVec> _funData;             ///< Return types of each fun statement.
+    };
+
+}  // namespace vnd
+
+// NOLINTEND(*-include-cleaner)
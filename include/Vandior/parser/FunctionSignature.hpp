@@ -0,0 +1,29 @@
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+#include "Vandior/lexer/TokenStream.hpp"
+
+namespace vnd {
+
+    /**
+     * @brief Name, parameters and return types of a fun statement, read from its tokens without touching them.
+     *
+     * A fun statement reads `fun name(parameters) returnType, returnType {`: the return types are the tokens between
+     * the last closing parenthesis and the opening curly bracket, separated by commas.
+     */
+    struct FunctionSignature {
+        std::string_view name;            ///< The name of the function.
+        TokenSpan parameters;             ///< The tokens between the parentheses of the parameter list.
+        StrViewVec returnTypes;           ///< The return types, in order, without the commas.
+        std::size_t returnTypesBegin{0};  ///< Index in the statement of the first token after the parameter list.
+
+        /**
+         * @brief Reads the signature of a fun statement in one pass over its tokens.
+         * @param statement The tokens of the statement, the fun keyword first.
+         * @return The signature; its views point into the statement tokens and into the source.
+         */
+        [[nodiscard]] static FunctionSignature parse(TokenSpan statement);
+    };
+
+}  // namespace vnd
+
+// NOLINTEND(*-include-cleaner)
@@ -17,7 +17,7 @@ namespace vnd {
          * @param elements The root element of the index.
          * @param token The token correspondent to the node.
          */
-        [[nodiscard]] IndexNode(std::unique_ptr<ASTNode> elements, const Token &token) noexcept;
+        [[nodiscard]] IndexNode(NodePtr<ASTNode> elements, const Token &token) noexcept;
 
         /**
          * @brief Gets the type of the AST node.
@@ -41,30 +41,36 @@ namespace vnd {
          * @brief Gets the elements of the node.
          * @return The elements of the node.
          */
-        [[nodiscard]] const std::unique_ptr<ASTNode> &get_elements() const noexcept;
+        [[nodiscard]] const NodePtr<ASTNode> &get_elements() const noexcept;
 
         /**
          * @brief Gets the index node of the node.
          * @return The index node of the node.
          */
-        [[nodiscard]] const std::unique_ptr<IndexNode> &get_index() const noexcept;
+        [[nodiscard]] const NodePtr<IndexNode> &get_index() const noexcept;
 
         /**
          * @brief Sets the index node of the node.
          * @param index The index node of the node.
          */
-        void set_index(std::unique_ptr<IndexNode> index) noexcept;
+        void set_index(NodePtr<IndexNode> index) noexcept;
         /**
          * @brief Gets the array node of the node.
          * @return The array node of the node.
          */
-        [[nodiscard]] const std::unique_ptr<ArrayNode> &get_array() const noexcept;
+        [[nodiscard]] const NodePtr<ArrayNode> &get_array() const noexcept;
 
         /**
          * @brief Sets the array node of the node.
          * @param _array The array node of the node.
          */
-        void set_array(std::unique_ptr<ArrayNode> _array) noexcept;
+        void set_array(NodePtr<ArrayNode> _array) noexcept;
+
+        /**
+         * @brief Moves the node and its children to another source after an edit that did not touch them.
+         * @param shift The source change.
+         */
+        void rebase(const SourceShift &shift) override;
 
         /**
          * @brief Swaps the contents of two LiteralNode objects.
@@ -80,9 +86,11 @@ namespace vnd {
         }
 
     private:
-        std::unique_ptr<ASTNode> m_elements;  ///< The elements child of the index.
-        std::unique_ptr<IndexNode> m_index;   ///< The possible index node of an array type.
-        std::unique_ptr<ArrayNode> m_array;   ///< The array elements of the index.
+        NodePtr<ASTNode> m_elements;  ///< The elements child of the index.
+        NodePtr<IndexNode> m_index;   ///< The possible index node of an array type.
+        NodePtr<ArrayNode> m_array;   ///< The array elements of the index.
+
+        static_assert(ownsNoResource<decltype(m_elements)> && ownsNoResource<decltype(m_index)> && ownsNoResource<decltype(m_array)>);
     };
 
 }  // namespace vnd
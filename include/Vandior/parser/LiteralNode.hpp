@@ -20,7 +20,8 @@ namespace vnd {
          * @param token The token correspondent to the node.
          * @param type NodeType of the node.
          */
-        [[nodiscard]] LiteralNode(T value, const Token &token, NodeType type) noexcept : ASTNode(token), m_value(value), m_type(type) {}
+        [[nodiscard]] LiteralNode(T value, const Token &token, NodeType type) noexcept
+          : ASTNode(token, literalKind()), m_value(value), m_type(type) {}
 
         /**
          * @brief Gets the type of the AST node.
@@ -52,6 +53,15 @@ namespace vnd {
          */
         [[nodiscard]] T get_value() const noexcept { return m_value; }
 
+        /**
+         * @brief Moves the node and its children to another source after an edit that did not touch them.
+         * @param shift The source change.
+         */
+        void rebase(const SourceShift &shift) override {
+            ASTNode::rebase(shift);
+            if constexpr(std::is_same_v<T, std::string_view>) { m_value = shift.apply(m_value); }
+        }
+
         /**
          * @brief Swaps the contents of two LiteralNode objects.
          * @param lhs The first LiteralNode.
@@ -64,9 +74,38 @@ namespace vnd {
             swap(lhs.m_type, rhs.m_type);
         }
 
+    protected:
+        /**
+         * @brief Constructs a LiteralNode of a derived class.
+         * @param value The value of the node.
+         * @param token The token correspondent to the node.
+         * @param type NodeType of the node.
+         * @param kind The concrete class of the node.
+         */
+        [[nodiscard]] LiteralNode(T value, const Token &token, NodeType type, NodeKind kind) noexcept
+          : ASTNode(token, kind), m_value(value), m_type(type) {}
+
     private:
+        /**
+         * @brief Gets the NodeKind of a literal holding a T.
+         * @return The kind, NodeKind::Unknown for the value types the parser does not build literals of.
+         */
+        [[nodiscard]] static constexpr NodeKind literalKind() noexcept {
+            if constexpr(std::is_same_v<T, bool>) {
+                return NodeKind::Boolean;
+            } else if constexpr(std::is_same_v<T, char>) {
+                return NodeKind::Char;
+            } else if constexpr(std::is_same_v<T, std::string_view>) {
+                return NodeKind::String;
+            } else {
+                return NodeKind::Unknown;
+            }
+        }
+
         T m_value;        ///< The literal value held by the node.
         NodeType m_type;  ///< The type of the node.
+
+        static_assert(ownsNoResource<T> && ownsNoResource<NodeType>);
     };
 
 }  // namespace vnd
@@ -19,6 +19,7 @@ enum class NodeType : std::uint8_t {
     Type,
     Index,
     Array,
+    Declaration,
     Statement,
     Unknown
 };
@@ -74,6 +75,9 @@ template <> struct fmt::formatter<NodeType> : fmt::formatter<std::string_view> {
         case Array:
             name = "ARRAY";
             break;
+        case Declaration:
+            name = "DECLARATION";
+            break;
         case Statement:
             name = "STATEMENT";
             break;
@@ -20,7 +20,7 @@ namespace vnd {
          * @param number_type NumberNodeType of the node.
          */
         [[nodiscard]] NumberNode(T value, const Token &token, NumberNodeType number_type) noexcept
-          : LiteralNode<T>(value, token, NodeType::Number), m_number_type(number_type) {}
+          : LiteralNode<T>(value, token, NodeType::Number, numberKind()), m_number_type(number_type) {}
 
         /**
          * @brief Gets the number type of the AST node.
@@ -50,7 +50,29 @@ namespace vnd {
         }
 
     private:
+        /**
+         * @brief Gets the NodeKind of a number holding a T.
+         * @return The kind, NodeKind::Unknown for the value types the parser does not build numbers of.
+         */
+        [[nodiscard]] static constexpr NodeKind numberKind() noexcept {
+            if constexpr(std::is_same_v<T, int>) {
+                return NodeKind::Integer;
+            } else if constexpr(std::is_same_v<T, float>) {
+                return NodeKind::Float;
+            } else if constexpr(std::is_same_v<T, double>) {
+                return NodeKind::Double;
+            } else if constexpr(std::is_same_v<T, std::complex<float>>) {
+                return NodeKind::ImaginaryFloat;
+            } else if constexpr(std::is_same_v<T, std::complex<double>>) {
+                return NodeKind::Imaginary;
+            } else {
+                return NodeKind::Unknown;
+            }
+        }
+
         NumberNodeType m_number_type;
+
+        static_assert(ownsNoResource<NumberNodeType>);
     };
 
 }  // namespace vnd
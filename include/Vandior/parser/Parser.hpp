@@ -5,6 +5,7 @@
 #pragma once
 #include "AST.hpp"
 #include "Vandior/lexer/Tokenizer.hpp"
+#include "Vandior/parser/FunctionSignature.hpp"
 #include "Vandior/parser/Statement.hpp"
 
 namespace vnd {
@@ -19,15 +20,93 @@ namespace vnd {
          * @param input The input string to be tokenized and parsed.
          * @param fileName The name of the file being parsed.
          */
-        [[nodiscard]] explicit Parser(const std::string_view &input, const std::string_view &fileName)
-          : tokenizer{input, fileName}, tokens{tokenizer.tokenize()} {}
+        [[nodiscard]] explicit Parser(const std::string_view &input, const std::string_view &fileName) : tokenizer{input, fileName} {}
 
         /**
-         * @brief Parses the tokens into an AST.
+         * @brief Constructs a Parser object that builds the AST nodes in an arena.
+         *
+         * The nodes are never deleted one by one: releasing or resetting the arena frees the whole AST at once, so
+         * the arena must outlive the statements parsed with it.
+         * @param input The input string to be tokenized and parsed.
+         * @param fileName The name of the file being parsed.
+         * @param arena The arena the nodes live in.
+         */
+        [[nodiscard]] Parser(const std::string_view &input, const std::string_view &fileName, Arena &arena)
+          : tokenizer{input, fileName}, _arena(&arena) {}
+
+        /**
+         * @brief Parses the tokens into an AST, pulling one statement at a time from the tokenizer.
          * @return A unique pointer to the root AST node.
          */
         std::vector<Statement> parse();
 
+        /**
+         * @brief Parses the tokens into an AST and keeps them for a later incremental parse.
+         * @param tokens Receives the tokens of the input.
+         * @return The parsed statements.
+         */
+        std::vector<Statement> parse(TokenStream &tokens);
+
+        /**
+         * @brief Parses tokens lexed beforehand, leaving them untouched.
+         * @param tokens The tokens, lexed from the input of this parser.
+         * @return The parsed statements.
+         */
+        std::vector<Statement> parseTokens(const TokenStream &tokens);
+
+        /// Number of statements a parseTokensParallel() worker claims at a time.
+        static inline constexpr std::size_t defaultBatchSize = 256;
+
+        /**
+         * @brief Parses tokens lexed beforehand on several threads, with the same result as parseTokens().
+         *
+         * Statements depend on nothing but their own tokens, so they are cut in batches that the workers claim one
+         * at a time from a shared counter: a worker done with a cheap batch takes the next one, so the load
+         * balances without any batch being pinned to a thread. Each worker has its own parser state and, if this
+         * parser builds the AST in an arena, its own arena, handed over to this parser's arena at the end. The
+         * statements come back in source order and the error thrown is the first one in source order.
+         * @param tokens The tokens, lexed from the input of this parser.
+         * @param threadCount The number of workers, the calling thread included, 0 for the hardware concurrency.
+         * @param batchSize The number of statements in a batch; inputs with a single batch are parsed on the
+         * calling thread.
+         * @return The parsed statements.
+         */
+        std::vector<Statement> parseTokensParallel(const TokenStream &tokens, std::size_t threadCount = 0,
+                                                   std::size_t batchSize = defaultBatchSize);
+
+        /**
+         * @brief Parses the input again after an edit, lexing and parsing only the statements the edit touched.
+         *
+         * The other statements are moved from the previous result and rebased on the edited input, so the input
+         * before the edit must still be alive.
+         * @param tokens The tokens of the input before the edit as left by the previous parse; receives the new ones.
+         * @param previous The statements parsed from the input before the edit.
+         * @param edit The edit that turned the previous input into the input of this parser.
+         * @return The parsed statements.
+         */
+        std::vector<Statement> parse(TokenStream &tokens, std::vector<Statement> previous, const SourceEdit &edit);
+
+        /**
+         * @brief Moves the parser to its input after an edit and parses it, lexing and parsing only the statements the
+         * edit touched.
+         *
+         * The SourceManager entry of the parser input is patched in place, so an editing session keeps a single entry
+         * per document. The input before the edit must still be alive.
+         * @param tokens The tokens of the current input as left by the previous parse; receives the new ones.
+         * @param previous The statements parsed from the current input.
+         * @param input The input after the edit.
+         * @param edit The edit that turned the current input into input.
+         * @return The parsed statements.
+         */
+        std::vector<Statement> parse(TokenStream &tokens, std::vector<Statement> previous, const std::string_view &input,
+                                     const SourceEdit &edit);
+
+        /**
+         * @brief Gets the tokenizer of the parser input, to lex it without parsing.
+         * @return The tokenizer.
+         */
+        [[nodiscard]] Tokenizer &getTokenizer() noexcept { return tokenizer; }
+
         /**
          * @brief Converts a string view to an integer.
          * @param str The string view to convert.
@@ -48,18 +127,60 @@ namespace vnd {
         static int convertToIntformOct(std::string_view str);
 
     private:
-        static const std::vector<StrViewVec> operatorPrecedence;  ///< Operator precedence levels.
-        static const std::vector<TokenType> types;                ///< Token types.
+        /**
+         * @brief Constructs a parseTokensParallel() worker over the input of another parser.
+         * @param owner The parser that spawns the worker.
+         * @param arena The arena of the nodes built by the worker, or nullptr to allocate each node on its own.
+         */
+        Parser(const Parser &owner, Arena *arena) : tokenizer{owner.tokenizer, std::pmr::get_default_resource()}, _arena(arena) {}
 
 #ifndef __llvm__
         template <typename T> static T handle_from_chars_error(const std::from_chars_result &result, std::string_view str);
 #endif
 
+        /**
+         * @brief Creates an AST node, in the arena if the parser has one.
+         * @tparam T The type of the node.
+         * @param args The arguments of the node constructor.
+         * @return The link to the node.
+         */
+        template <typename T, typename... Args> [[nodiscard]] NodePtr<T> makeNode(Args &&...args) {
+            if(_arena == nullptr) { return MAKE_UNIQUE(T, std::forward<Args>(args)...); }
+            // No finalizer is registered: every node member asserts ownsNoResource, so skipping the destructors leaks nothing.
+            return NodePtr<T>{::new(_arena->allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...), NodeDeleter{false}};
+        }
+
+        /**
+         * @brief Parses the statements an edit touched and moves the others from the previous result.
+         * @param tokens Receives the tokens of the edited input.
+         * @param previous The statements parsed from the input before the edit.
+         * @param relex The tokens of the edited input and the statements lexed again.
+         * @param moved The source change of the statements after the edit.
+         * @return The parsed statements.
+         */
+        std::vector<Statement> reparse(TokenStream &tokens, std::vector<Statement> previous, RelexResult relex, const SourceShift &moved);
+
+        /**
+         * @brief Parses the tokens of a statement and emplaces it in the parsing result.
+         * @param statement The tokens of the statement.
+         * @param statements The parsing result.
+         */
+        void parseStatement(TokenSpan statement, std::vector<Statement> &statements);
+
         /**
          * @brief create a statement and emplace it in the parsing result.
          */
         void emplaceStatement(std::vector<Statement> &statements);
 
+        /**
+         * @brief Splits the expression of a declaration statement into its names, type and initializers.
+         *
+         * `names: type = initializers` parses as '=' over ':', with either one optional.
+         * @param expression The expression of the statement.
+         * @return The declaration node.
+         */
+        NodePtr<ASTNode> makeDeclaration(NodePtr<ASTNode> expression);
+
         /**
          * @brief Consumes the current token and advances to the next token.
          */
@@ -78,8 +199,6 @@ namespace vnd {
          */
         static std::size_t getUnaryOperatorPrecedence(const Token &token) noexcept;
 
-        static std::size_t adjustPrecedenceForVar(const std::string_view &tokenValue, std::size_t precedence) noexcept;
-
         /**
          * @brief Gets the precedence of an operator.
          * @param token The token representing the operator.
@@ -110,76 +229,88 @@ namespace vnd {
          * @param currentValue The string view of the current token's value.
          * @return A unique pointer to the parsed AST node representing the integer.
          */
-        std::unique_ptr<ASTNode> parsePrimaryInteger(const Token &currentToken, std::string_view currentValue);
+        NodePtr<ASTNode> parsePrimaryInteger(const Token &currentToken, std::string_view currentValue);
         /**
          * @brief Parses a primary double expression.
          * @param currentToken The current token being parsed.
          * @param currentValue The string view of the current token's value.
          * @return A unique pointer to the parsed AST node representing the double.
          */
-        std::unique_ptr<ASTNode> parsePrimaryDouble(const Token &currentToken, const std::string_view &currentValue);
+        NodePtr<ASTNode> parsePrimaryDouble(const Token &currentToken, const std::string_view &currentValue);
         /**
-         * @brief Parses a primary expression.
-         * @return A unique pointer to the parsed AST node.
+         * @brief What an open expression frame waits for before it can produce its node.
          */
-        std::unique_ptr<ASTNode> parsePrimary();
+        enum class FrameKind : std::uint8_t {
+            Binary,       ///< An operand, then the binary operators binding tighter than the frame precedence.
+            Unary,        ///< The operand of a prefix operator.
+            Parenthesis,  ///< The expression between parentheses.
+            Array,        ///< The elements of an array literal.
+            Call,         ///< The arguments of a function call.
+            Index,        ///< The expression between square brackets.
+            IndexArray    ///< The elements of the array literal following an index.
+        };
+
         /**
-         * @brief Parses a unary expression.
-         * @param parentPrecendence The precedence level of the parent expression.
-         * @return A unique pointer to the parsed AST node.
+         * @brief A partially parsed expression, kept on the explicit stack of parseExpression().
          */
-        std::unique_ptr<ASTNode> parseUnary(std::size_t parentPrecendence);
+        struct ExpressionFrame {
+            FrameKind kind;          ///< What the frame waits for.
+            std::size_t precedence;  ///< The precedence of the parent operator, for Binary frames.
+            const Token *token;      ///< The pending operator or the opening bracket.
+            NodePtr<ASTNode> node;   ///< The left operand, or the node the brackets belong to.
+            ASTNode *owner;          ///< The node receiving the index (Index) or the array (IndexArray).
+        };
 
         /**
-         * @brief Parses a binary expression.
-         * @param parentPrecendence The precedence level of the parent expression.
-         * @return A unique pointer to the parsed AST node.
+         * @brief Throws if a token opening a nested expression is the last one of the expression.
+         * @param token The token.
          */
-        std::unique_ptr<ASTNode> parseBinary(std::size_t parentPrecendence);
+        void requireFollowingToken(const Token &token) const;
 
         /**
-         * @brief Parses an expression.
-         * @param parentPrecendence The precedence level of the parent expression (default is 0).
-         * @return A unique pointer to the parsed AST node.
+         * @brief Opens a frame waiting for a nested expression, and the Binary frame parsing it.
+         * @param kind What the frame waits for.
+         * @param token The opening bracket.
+         * @param node The node the brackets belong to.
+         * @param owner The node receiving the index or the array.
          */
-        std::unique_ptr<ASTNode> parseExpression(std::size_t parentPrecendence = 0);
+        void openExpression(FrameKind kind, const Token &token, NodePtr<ASTNode> node = nullptr, ASTNode *owner = nullptr);
 
-        // FIXME: Function parameters should not be of type "std::unique_ptr<T> const &"
         /**
-         * @brief Parses an index expression.
-         * @tparam T The type of the node.
-         * @param node The node to parse the index for.
+         * @brief Parses the prefix operators and the primary expression of an operand.
+         * @return The operand, or nullptr if a bracket was opened and its contents are parsed next.
          */
-        template <typename T> void parseIndex(const std::unique_ptr<T> &node);
-
-        // FIXME: Function parameters should not be of type "std::unique_ptr<T> const &"
+        NodePtr<ASTNode> parseOperand();
         /**
-         * @brief Parses an array expression.
-         * @param node The node to parse the array for.
-         * @return True if the array was successfully parsed, false otherwise.
+         * @brief Parses a primary expression.
+         * @return The parsed node, or nullptr if a bracket was opened and its contents are parsed next.
          */
-        [[nodiscard]] bool parseArray(const std::unique_ptr<IndexNode> &node);
+        NodePtr<ASTNode> parsePrimary();
 
-        // FIXME: Function parameters should not be of type "std::unique_ptr<T> const &"
         /**
-         * @brief Parses a function call expression.
-         * @param node The node to parse the function call for.
-         * @return True if the function call was successfully parsed, false otherwise.
+         * @brief Parses an expression with an explicit stack of frames instead of recursion.
+         *
+         * Operator precedence climbing, parentheses, calls, indexes and array literals all push a frame on
+         * expressionFrames, so nesting depth costs buffer space reused across statements, not call stack.
+         * @return A unique pointer to the parsed AST node.
          */
-        [[nodiscard]] bool parseCall(const std::unique_ptr<VariableNode> &node);
+        NodePtr<ASTNode> parseExpression();
 
         /**
-         * @brief Extract the function data from a fun statement tokens.
-         * @return The return types of the function.
+         * @brief Parses the indexes following a node, and the array literal that may follow the last one.
+         * @param node The node the indexes belong to, returned once they are parsed.
+         * @param owner The node receiving the next index: node itself or its last index.
+         * @return The node, or nullptr if a bracket was opened and its contents are parsed next.
          */
-        [[nodiscard]] StringVec extractFunData();
+        NodePtr<ASTNode> parseIndex(NodePtr<ASTNode> node, ASTNode &owner);
 
-        Tokenizer tokenizer;                  ///< The tokenizer used to tokenize the input.
-        std::vector<TokenVec> tokens{};       ///< The list of tokens.
-        TokenVec *currentStatement{nullptr};  ///< The current statement being parsed.
-        std::size_t tokenSize{};              ///< The size of the token list.
-        std::size_t position{};               ///< The current position in the token list.
-        Token keyword{};                      ///< The keyword token of the current statement.
+        Tokenizer tokenizer;           ///< The tokenizer used to tokenize the input.
+        TokenSpan currentStatement{};  ///< The tokens of the current statement being parsed.
+        std::size_t tokenSize{};       ///< The size of the token list.
+        std::size_t position{};        ///< The current position in the token list.
+        Token keyword{};               ///< The keyword token of the current statement.
+        Arena *_arena{nullptr};        ///< The arena of the AST nodes, or nullptr to allocate each node on its own.
+        std::vector<ExpressionFrame> expressionFrames;  ///< The open frames of parseExpression(), reused across statements.
     };
 }  // namespace vnd
 
@@ -9,8 +9,8 @@ namespace vnd {
 
     class Statement : public ASTNode {
     public:
-        [[nodiscard]] explicit Statement(const Token &token, const std::vector<std::string> &_funData) noexcept
-          : ASTNode(token), funData(_funData) {}
+        [[nodiscard]] explicit Statement(const Token &token, StrViewVec _funData) noexcept
+          : ASTNode(token, NodeKind::Statement), funData(std::move(_funData)) {}
 
         /**
          * @brief Gets the type of the AST node.
@@ -34,19 +34,30 @@ namespace vnd {
          * @brief Returns the pointer to the statment nodes.
          * @return The the pointer to the statment nodes.
          */
-        [[nodiscard]] const std::unique_ptr<ASTNode> &get_root() const noexcept { return _root; }
+        [[nodiscard]] const NodePtr<ASTNode> &get_root() const noexcept { return _root; }
 
         /**
          * @brief Sets the pointer to the statment nodes.
          * @param node The the pointer to the statment nodes.
          */
-        void set_root(std::unique_ptr<ASTNode> root) noexcept { _root = std::move(root); }
+        void set_root(NodePtr<ASTNode> root) noexcept { _root = std::move(root); }
 
         /**
          * @brief Returns the vector of the function return types.
-         * @return The vector of the function return types. If the statmement is not a function, an empty vector is returned.
+         * @return The vector of the function return types, viewing the source. If the statmement is not a function, an
+         * empty vector is returned.
          */
-        [[nodiscard]] const std::vector<std::string> &get_funData() const noexcept { return funData; }
+        [[nodiscard]] const StrViewVec &get_funData() const noexcept { return funData; }
+
+        /**
+         * @brief Moves the statement and its nodes to another source after an edit that did not touch them.
+         * @param shift The source change.
+         */
+        void rebase(const SourceShift &shift) override {
+            ASTNode::rebase(shift);
+            if(_root) { _root->rebase(shift); }
+            for(auto &type : funData) { type = shift.apply(type); }
+        }
 
         friend void swap(Statement &lhs, Statement &rhs) noexcept {
             using std::swap;
@@ -56,8 +67,8 @@ namespace vnd {
         }
 
     private:
-        std::unique_ptr<ASTNode> _root;
-        std::vector<std::string> funData;
+        NodePtr<ASTNode> _root;
+        StrViewVec funData;
     };
 
 }  // namespace vnd
@@ -20,7 +20,7 @@ namespace vnd {
          * @param token The token correspondent to the node.
          */
         [[nodiscard]] explicit TypeNode(const Token &token) noexcept
-          : ASTNode(token), m_value(token.getValue()), m_type(token.getType()), m_index(nullptr) {}
+          : ASTNode(token, NodeKind::Type), m_value(token.getValue()), m_type(token.getType()), m_index(nullptr) {}
 
         /**
          * @brief Gets the type of the AST node.
@@ -50,13 +50,13 @@ namespace vnd {
          * @brief Gets the index node of the node.
          * @return The index node of the node.
          */
-        [[nodiscard]] const std::unique_ptr<IndexNode> &get_index() const noexcept { return m_index; }
+        [[nodiscard]] const NodePtr<IndexNode> &get_index() const noexcept { return m_index; }
 
         /**
          * @brief Sets the index node of the node.
          * @param index The index node of the node.
          */
-        void set_index(std::unique_ptr<IndexNode> index) noexcept {
+        void set_index(NodePtr<IndexNode> index) noexcept {
             m_index = vnd_move_always_even_const(index);
             if(m_index) { m_index->set_parent(this); }
         }
@@ -67,6 +67,16 @@ namespace vnd {
          */
         [[nodiscard]] TokenType getVariableType() const noexcept { return m_type; }
 
+        /**
+         * @brief Moves the node and its children to another source after an edit that did not touch them.
+         * @param shift The source change.
+         */
+        void rebase(const SourceShift &shift) override {
+            ASTNode::rebase(shift);
+            m_value = shift.apply(m_value);
+            if(m_index) { m_index->rebase(shift); }
+        }
+
         friend void swap(TypeNode &lhs, TypeNode &rhs) noexcept {
             using std::swap;
             swap(static_cast<ASTNode &>(lhs), static_cast<ASTNode &>(rhs));
@@ -78,7 +88,9 @@ namespace vnd {
     private:
         std::string_view m_value;            ///< The value of the node.
         TokenType m_type;                    ///< The type of the token node.
-        std::unique_ptr<IndexNode> m_index;  ///< The possible index node of an array type.
+        NodePtr<IndexNode> m_index;  ///< The possible index node of an array type.
+
+        static_assert(ownsNoResource<decltype(m_value)> && ownsNoResource<decltype(m_type)> && ownsNoResource<decltype(m_index)>);
     };
 
 }  // namespace vnd
@@ -21,8 +21,8 @@ namespace vnd {
          * @param op_Token token of the operator for the unary expression.
          * @param _operand Operand of the unary expression.
          */
-        [[nodiscard]] UnaryExpressionNode(std::string_view _op, const Token &op_Token, std::unique_ptr<ASTNode> _operand) noexcept
-          : ASTNode(op_Token), op(_op), operand(vnd_move_always_even_const(_operand)) {
+        [[nodiscard]] UnaryExpressionNode(std::string_view _op, const Token &op_Token, NodePtr<ASTNode> _operand) noexcept
+          : ASTNode(op_Token, NodeKind::UnaryExpression), op(_op), operand(vnd_move_always_even_const(_operand)) {
             if(operand) operand->set_parent(this);
         }
 
@@ -31,8 +31,8 @@ namespace vnd {
          * @param op_Token token of the operator for the unary expression.
          * @param _operand Operand of the unary expression.
          */
-        [[nodiscard]] UnaryExpressionNode(const Token &op_Token, std::unique_ptr<ASTNode> _operand) noexcept
-          : ASTNode(op_Token), op(op_Token.getValue()), operand(vnd_move_always_even_const(_operand)) {
+        [[nodiscard]] UnaryExpressionNode(const Token &op_Token, NodePtr<ASTNode> _operand) noexcept
+          : ASTNode(op_Token, NodeKind::UnaryExpression), op(op_Token.getValue()), operand(vnd_move_always_even_const(_operand)) {
             if(operand) operand->set_parent(this);
         }
 
@@ -49,13 +49,23 @@ namespace vnd {
          * @brief Gets the operand of the unary expression.
          * @return The operand of the unary expression.
          */
-        [[nodiscard]] const std::unique_ptr<ASTNode> &getOperand() const noexcept { return operand; }
+        [[nodiscard]] const NodePtr<ASTNode> &getOperand() const noexcept { return operand; }
         /**
          * @brief Gets the operand of the unary expression.
          * @return The operand of the unary expression.
          */
         [[nodiscard]] const ASTNode &getOperandr() const noexcept { return *operand.get(); }
 
+        /**
+         * @brief Moves the node and its children to another source after an edit that did not touch them.
+         * @param shift The source change.
+         */
+        void rebase(const SourceShift &shift) override {
+            ASTNode::rebase(shift);
+            op = shift.apply(op);
+            if(operand) { operand->rebase(shift); }
+        }
+
         friend void swap(UnaryExpressionNode &lhs, UnaryExpressionNode &rhs) noexcept {
             using std::swap;
             swap(static_cast<ASTNode &>(lhs), static_cast<ASTNode &>(rhs));
@@ -65,7 +75,9 @@ namespace vnd {
 
     private:
         std::string_view op;               ///< Operator for the unary expression.
-        std::unique_ptr<ASTNode> operand;  ///< Operand of the unary expression.
+        NodePtr<ASTNode> operand;  ///< Operand of the unary expression.
+
+        static_assert(ownsNoResource<decltype(op)> && ownsNoResource<decltype(operand)>);
     };
 
 }  // namespace vnd
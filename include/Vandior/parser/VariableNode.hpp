@@ -21,7 +21,7 @@ namespace vnd {
          * @param name_Token token of the name of the variable.
          */
         explicit VariableNode(std::string_view _name, const Token &name_Token) noexcept
-          : ASTNode(name_Token), name(_name), m_is_call(false), m_index(nullptr), m_call(nullptr) {}
+          : ASTNode(name_Token, NodeKind::Variable), name(_name), m_is_call(false), m_index(nullptr), m_call(nullptr) {}
 
         [[nodiscard]] NodeType getType() const noexcept override { return NodeType::Variable; }
 
@@ -35,13 +35,13 @@ namespace vnd {
          * @brief Gets the index node of the node.
          * @return The index node of the node.
          */
-        [[nodiscard]] const std::unique_ptr<IndexNode> &get_index() const noexcept { return m_index; }
+        [[nodiscard]] const NodePtr<IndexNode> &get_index() const noexcept { return m_index; }
 
         /**
          * @brief Sets the index node of the node.
          * @param index The index node of the node.
          */
-        void set_index(std::unique_ptr<IndexNode> index) noexcept {
+        void set_index(NodePtr<IndexNode> index) noexcept {
             m_index = vnd_move_always_even_const(index);
             if(m_index) { m_index->set_parent(this); }
         }
@@ -50,18 +50,29 @@ namespace vnd {
          * @brief Gets the call node of the node.
          * @return The call node of the node.
          */
-        [[nodiscard]] const std::unique_ptr<ASTNode> &get_call() const noexcept { return m_call; }
+        [[nodiscard]] const NodePtr<ASTNode> &get_call() const noexcept { return m_call; }
 
         /**
          * @brief Sets the call node of the node.
          * @param call The call node of the node.
          */
-        void set_call(std::unique_ptr<ASTNode> call = nullptr) noexcept {
+        void set_call(NodePtr<ASTNode> call = nullptr) noexcept {
             m_is_call = true;
             m_call = vnd_move_always_even_const(call);
             if(m_call) { m_call->set_parent(this); }
         }
 
+        /**
+         * @brief Moves the node and its children to another source after an edit that did not touch them.
+         * @param shift The source change.
+         */
+        void rebase(const SourceShift &shift) override {
+            ASTNode::rebase(shift);
+            name = shift.apply(name);
+            if(m_index) { m_index->rebase(shift); }
+            if(m_call) { m_call->rebase(shift); }
+        }
+
         friend void swap(VariableNode &lhs, VariableNode &rhs) noexcept {
             using std::swap;
             swap(static_cast<ASTNode &>(lhs), static_cast<ASTNode &>(rhs));
@@ -72,8 +83,11 @@ namespace vnd {
     private:
         std::string_view name;               ///< The name of the variable.
         bool m_is_call;                      ///< A bool indicates if the indentifier is a call to a function.
-        std::unique_ptr<IndexNode> m_index;  ///< The possible index node of an array type.
-        std::unique_ptr<ASTNode> m_call;     ///< The possible call node of an array type.
+        NodePtr<IndexNode> m_index;  ///< The possible index node of an array type.
+        NodePtr<ASTNode> m_call;     ///< The possible call node of an array type.
+
+        static_assert(ownsNoResource<decltype(name)> && ownsNoResource<decltype(m_is_call)> && ownsNoResource<decltype(m_index)> &&
+                      ownsNoResource<decltype(m_call)>);
     };
 
 }  // namespace vnd
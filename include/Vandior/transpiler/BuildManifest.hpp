@@ -0,0 +1,112 @@
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "../fs/fs.hpp"
+#include "../headers.hpp"
+
+namespace vnd {
+
+    /**
+     * @brief 64-bit FNV-1a hash, fed piece by piece.
+     */
+    class ContentHash {
+    public:
+        /**
+         * @brief Feeds bytes to the hash.
+         * @param data The bytes.
+         * @return The hash, to chain further calls.
+         */
+        constexpr ContentHash &add(const std::string_view data) noexcept {
+            for(const auto byte : data) { mix(C_UC(byte)); }
+            return *this;
+        }
+
+        /**
+         * @brief Feeds an integer to the hash, its bytes from the least significant.
+         * @param value The integer.
+         * @return The hash, to chain further calls.
+         */
+        constexpr ContentHash &add(std::uint64_t value) noexcept {
+            for(std::size_t i = 0; i < sizeof(value); ++i, value >>= 8U) { mix(value & 0xFFU); }
+            return *this;
+        }
+
+        [[nodiscard]] constexpr std::uint64_t value() const noexcept { return _value; }
+
+    private:
+        constexpr void mix(const std::uint64_t byte) noexcept { _value = (_value ^ byte) * 0x100000001B3ULL; }
+
+        std::uint64_t _value{0xCBF29CE484222325ULL};  ///< The hash of the bytes fed so far.
+    };
+
+    /**
+     * @brief Hashes of the files generated by the last run, kept in the build folder between runs.
+     *
+     * Every generated file is recorded by name with the hash of the source it was generated from and the hash of its
+     * code, so the next run can skip generating a function whose source did not change and skip writing a file whose
+     * code did not change. The manifest is a text file: a `generator <name>` line with the generator that wrote the
+     * files, so a run of another Vandior build does not reuse code it would generate differently, then one
+     * `name sourceHash codeHash` line per file.
+     */
+    class BuildManifest {
+    public:
+        /**
+         * @brief What the manifest records about a generated file.
+         */
+        struct Entry {
+            std::uint64_t sourceHash{0};  ///< Hash of the statements the file was generated from.
+            std::uint64_t codeHash{0};    ///< Hash of the generated code.
+        };
+
+        /**
+         * @brief Reads a manifest; a missing file gives an empty manifest and malformed lines are skipped.
+         * @param path The path of the manifest.
+         * @return The manifest.
+         */
+        [[nodiscard]] static BuildManifest load(const fs::path &path);
+
+        /**
+         * @brief Writes the manifest.
+         * @param path The path of the manifest.
+         * @return True if the file was written.
+         */
+        [[nodiscard]] bool save(const fs::path &path) const;
+
+        /**
+         * @brief Looks a file up.
+         * @param name The name of the file.
+         * @return The entry of the file, or nullptr if it is not recorded.
+         */
+        [[nodiscard]] const Entry *find(std::string_view name) const noexcept;
+
+        /**
+         * @brief Records a file, replacing its previous entry.
+         * @param name The name of the file.
+         * @param entry The entry of the file.
+         */
+        void set(std::string_view name, const Entry &entry);
+
+        /**
+         * @brief Forgets a file.
+         * @param name The name of the file.
+         */
+        void erase(std::string_view name);
+
+        [[nodiscard]] const std::map<std::string, Entry, std::less<>> &entries() const noexcept { return _entries; }
+
+        [[nodiscard]] const std::string &generator() const noexcept { return _generator; }
+
+        /**
+         * @brief Records the generator that wrote the files.
+         * @param generator The full name of the generator.
+         */
+        void setGenerator(std::string generator) noexcept { _generator = std::move(generator); }
+
+    private:
+        std::string _generator;                               ///< The generator that wrote the files, empty if unknown.
+        std::map<std::string, Entry, std::less<>> _entries;  ///< The entries, by file name.
+    };
+
+}  // namespace vnd
+
+// NOLINTEND(*-include-cleaner)
@@ -22,6 +22,12 @@ namespace vnd {
         // Getter per ottenere il percorso del file principale .cpp
         [[nodiscard]] std::optional<fs::path> getMainOutputFilePath() const;
 
+        // Getter per ottenere il percorso di un file generato (l'header o un .cpp) all'interno della cartella 'src'
+        [[nodiscard]] std::optional<fs::path> getSourceFilePath(const std::string_view &fileName) const;
+
+        // Getter per ottenere il percorso del manifest con gli hash dei file generati, nella cartella 'vnbuild'
+        [[nodiscard]] std::optional<fs::path> getManifestFilePath() const;
+
     private:
         bool _createCmakeListsFile;
         std::string_view _filename;                   // Nome del file di input
@@ -2,15 +2,70 @@
 #pragma once
 
 #include "../lexer/TokenType.hpp"
-#include "../parser/Parser.hpp"
+#include "../parser/CompilationUnit.hpp"
+#include "BuildManifest.hpp"
 #include "ProjectBuilder.hpp"
 
 namespace vnd {
     class Transpiler {
     public:
+        /// Growable buffer the code generator appends to; a single one is passed down the whole walk.
+        using OutputBuffer = fmt::memory_buffer;
+
         Transpiler(const std::string_view &input, const std::string_view &filename, bool createCmakeListsFile = false);
+
+        /**
+         * @brief Constructs a transpiler that borrows the tokens and the AST of a compilation unit.
+         * @param unit The unit to transpile; it must outlive the transpiler.
+         * @param createCmakeListsFile True to create a CMakeLists.txt file in the build folder.
+         */
+        explicit Transpiler(CompilationUnit &unit, bool createCmakeListsFile = false);
+
         std::string transpile();
 
+        /**
+         * @brief Generates the code of already parsed statements, without touching the output files.
+         * @param ast The statements in flat form.
+         * @return The generated code.
+         */
+        std::string transpile(const FlatAST &ast);
+
+        /**
+         * @brief A file of a project split into translation units.
+         */
+        struct GeneratedFile {
+            std::string name;             ///< The name of the file inside the src folder.
+            std::string code;             ///< The generated code, empty when the file was reused.
+            std::uint64_t sourceHash{0};  ///< Hash of the tokens of the fun the file comes from, 0 for the others.
+            std::uint64_t codeHash{0};    ///< Hash of the generated code.
+            bool reused{false};           ///< True when the source did not change and the code was not generated again.
+        };
+
+        /**
+         * @brief Transpiles every fun concurrently into its own translation unit and writes the files in the src folder.
+         *
+         * The prototypes of the functions and the top-level declarations go into a header included by every unit, so
+         * the units do not depend on each other and the C++ compiler can build them in parallel. A manifest in the build
+         * folder keeps the hashes of the last run: functions whose tokens did not change are not generated again, files
+         * whose code did not change are not written again, so their modification times stay put and the C++ build
+         * skips them, and the files of removed functions are deleted.
+         * @param threadCount The number of threads, 0 for one per hardware thread.
+         * @return The generated files: the header, the main file, then one file per fun in source order.
+         */
+        std::vector<GeneratedFile> transpileUnits(std::size_t threadCount = 0);
+
+        /**
+         * @brief Splits already parsed statements into translation units, without touching the output files.
+         * @param ast The statements in flat form.
+         * @param baseName The name the files are named after: `baseName.hpp`, `baseName.cpp` and `baseName_fun.cpp`,
+         * or `baseName_fun-2.cpp` and so on for the later overloads of a fun.
+         * @param threadCount The number of threads, 0 for one per hardware thread.
+         * @param previous The manifest of the last run, or nullptr to generate every fun.
+         * @return The generated files: the header, the main file, then one file per fun in source order.
+         */
+        std::vector<GeneratedFile> transpileUnits(const FlatAST &ast, std::string_view baseName, std::size_t threadCount = 0,
+                                                  const BuildManifest *previous = nullptr);
+
         /**
          * @brief Maps a given type to a corresponding string view.
          *
@@ -20,131 +75,178 @@ namespace vnd {
         static auto mapType(const std::string_view type) -> std::string;
 
     private:
+        /**
+         * @brief Code still to emit while walking an expression: a node to transpile, or text when node is noNode.
+         */
+        struct PendingCode {
+            explicit(false) PendingCode(const NodeId codeNode) noexcept : node(codeNode) {}
+            explicit(false) PendingCode(const std::string_view codeText) noexcept : text(codeText) {}
+
+            NodeId node{noNode};    ///< The node to transpile.
+            std::string_view text;  ///< The text to append.
+        };
+
+        /**
+         * Creates the build folders and records their paths.
+         */
+        void setupProject();
+
         /**
          * Creates a mock file.
          */
         void createMockfile() const;
 
+        /**
+         * Transpiles a statement, its keyword first, appending one line to the output.
+         *
+         * @param ast The flat AST holding the statement.
+         * @param statement The index of the statement.
+         * @param out The buffer the code is appended to.
+         */
+        void transpileStatement(const FlatAST &ast, std::size_t statement, OutputBuffer &out);
+
+        /**
+         * Transpiles the signature of a fun statement, without the opening curly bracket: `auto name(params) -> type`.
+         *
+         * @param ast The flat AST holding the statement.
+         * @param statement The index of the fun statement.
+         * @param out The buffer the code is appended to.
+         */
+        void transpileFunctionSignature(const FlatAST &ast, std::size_t statement, OutputBuffer &out);
+
         /**
          * Transpiles the given Token keyword into a string representation.
          *
          * @param keyword the Token to transpile.
          * @return The transpiled string representation of the keyword.
          */
-        static auto transpileKeyword(const Token &keyword) -> std::string;
+        static auto transpileKeyword(const Token &keyword) -> std::string_view;
 
         /**
-         * Parses a declaration statement.
+         * @brief Maps a given type to the name of the corresponding C++ type, without copying it.
          *
-         * @param input the string to parse.
-         * @return The parsed string.
+         * @param type The type to be mapped.
+         * @return The C++ type name, or type itself when it has no mapping.
          */
-        static std::string parseDeclaration(std::string input);
+        static auto mapTypeName(std::string_view type) -> std::string_view;
 
         /**
-         * Transpiles the given ASTNode into a string representation.
+         * Gathers the items of a ',' separated list, in order.
          *
-         * @param node The ASTNode to transpile.
-         * @return The transpiled string representation of the node.
+         * @param ast The flat AST holding the list.
+         * @param list The list: a ',' expression, a single item or noNode.
+         * @param items Receives the items.
          */
-        auto transpileNode(const ASTNode &node) -> std::string;
+        static void collectList(const FlatAST &ast, NodeId list, std::vector<NodeId> &items);
 
         /**
-         * @brief Transpiles a binary expression node with a specific format.
-         *
-         * This function takes a binary expression node and an output stream, and transpiles the node
-         * into a string representation using the specified format.
+         * Transpiles the given node, appending its code to the output. The tree is walked with an explicit stack of
+         * PendingCode, so its depth is bounded by memory and not by the call stack: the helpers below append the text
+         * that opens a node and queue the children and the text that follow it.
          *
-         * @param binaryNode The binary expression node to transpile.
-         * @param code The output stream to write the transpiled code to.
-         * @param format The format to use for transpiling the binary expression node.
+         * @param ast The flat AST holding the node.
+         * @param node The node to transpile.
+         * @param out The buffer the code is appended to.
          */
-        void transpileBinaryExpressionNodeWhitFormat(const BinaryExpressionNode *binaryNode, std::ostringstream &code,
-                                                     const std::string &format);
+        void transpileNode(const FlatAST &ast, NodeId node, OutputBuffer &out);
+
         /**
          * Transpiles a binary expression node.
          *
+         * @param ast The flat AST holding the node.
          * @param binaryNode The binary expression node to transpile.
-         * @return The transpiled binary expression as a string.
+         * @param pending The code queued after the node, in order.
          */
-        auto transpileBinaryExpressionNode(const BinaryExpressionNode *binaryNode) -> std::string;
+        void transpileBinaryExpressionNode(const FlatAST &ast, NodeId binaryNode, std::vector<PendingCode> &pending);
         /**
          * Transpiles a unary expression node.
          *
+         * @param ast The flat AST holding the node.
          * @param unaryNode The unary expression node to transpile.
-         * @return The transpiled unary expression as a string.
+         * @param out The buffer the code is appended to.
+         * @param pending The code queued after the node, in order.
          */
-        auto transpileUnaryExpressionNode(const UnaryExpressionNode *unaryNode) -> std::string;
+        void transpileUnaryExpressionNode(const FlatAST &ast, NodeId unaryNode, OutputBuffer &out, std::vector<PendingCode> &pending);
         /**
-         * Transpiles a variable node into a string representation.
+         * Transpiles a variable node, with its indexes and its call arguments.
          *
+         * @param ast The flat AST holding the node.
          * @param variableNode The variable node to transpile.
-         * @return The string representation of the transpiled variable node.
+         * @param pending The code queued after the node, in order.
          */
-        auto transpileVariableNode(const VariableNode *variableNode) -> std::string;
+        void transpileVariableNode(const FlatAST &ast, NodeId variableNode, std::vector<PendingCode> &pending);
         /**
          * @brief Transpiles a numeric node.
          *
-         * This function takes a pointer to a NumberNode and transpiles it into a string representation.
-         * The transpiled string is returned.
+         * @param ast The flat AST holding the node.
+         * @param numberNode The number node to transpile.
+         * @param out The buffer the code is appended to.
+         */
+        static void transpileNumericNode(const FlatAST &ast, NodeId numberNode, OutputBuffer &out);
+        /**
+         * @brief Transpiles a boolean, char or string literal node.
          *
-         * @tparam T The type of the numeric value.
-         * @param numberNode Pointer to the NumberNode to be transpiled.
-         * @return The transpiled string representation of the numeric node.
+         * @param ast The flat AST holding the node.
+         * @param literalNode The literal node to transpile.
+         * @param out The buffer the code is appended to.
          */
-        template <typename T> auto transpileNumericNode(const NumberNode<T> *numberNode) -> std::string;
+        static void transpileLiteralNode(const FlatAST &ast, NodeId literalNode, OutputBuffer &out);
+        template <typename T> static auto getValueOrLog(const std::optional<T> &opt, std::string_view errorMsg) -> T;
         /**
-         * @brief Transpiles a literal node to a string representation.
+         * Transpiles the given type node, with its indexes.
          *
-         * This function takes a literal node as input and returns a string representation of the node.
-         * The template parameter `T` specifies the type of the literal value.
+         * @param ast The flat AST holding the node.
+         * @param typeNode The type node to be transpiled.
+         * @param out The buffer the code is appended to.
+         * @param pending The code queued after the node, in order.
+         */
+        void transpileTypeNode(const FlatAST &ast, NodeId typeNode, OutputBuffer &out, std::vector<PendingCode> &pending);
+        /**
+         * Transpiles a name followed by an index chain: every index wraps the type of the next one, and the innermost
+         * wraps the name.
          *
-         * @param literalNode A pointer to the literal node to be transpiled.
-         * @return The string representation of the transpiled literal node.
+         * @param ast The flat AST holding the nodes.
+         * @param indexNode The first index of the chain, or noNode.
+         * @param name The transpiled name the chain applies to.
+         * @param pending The code queued after the node, in order.
          */
-        template <typename T> auto transpileLiteralNode(const LiteralNode<T> *literalNode) -> std::string;
-        template <typename T> static auto getValueOrLog(const std::optional<T> &opt, std::string_view errorMsg) -> T;
+        void transpileIndexNode(const FlatAST &ast, NodeId indexNode, std::string_view name, std::vector<PendingCode> &pending);
         /**
-         * Transpiles the given TypeNode into a string representation.
+         * Transpiles the array literal following an index chain as constructor arguments, if there is one.
          *
-         * @param typeNode The TypeNode to be transpiled.
-         * @return The string representation of the transpiled TypeNode.
+         * @param ast The flat AST holding the nodes.
+         * @param indexNode The first index of the chain, or noNode.
+         * @param pending The code queued after the node, in order.
          */
-        auto transpileTypeNode(const TypeNode *typeNode) -> std::string;
+        void transpileIndexArray(const FlatAST &ast, NodeId indexNode, std::vector<PendingCode> &pending);
         /**
-         * Transpiles the given IndexNode into a string representation.
+         * Transpiles a declaration node, pairing every name with its initializer: `type a = 1, b = 2`.
          *
-         * @param indexNode The IndexNode to transpile.
-         * @return A pair containing the transpiled string representation of the IndexNode and of the ArrayNode.
+         * @param ast The flat AST holding the node.
+         * @param declarationNode The declaration node to transpile.
+         * @param pending The code queued after the node, in order.
+         * @param declaredNames Scratch list receiving the declared names.
+         * @param initializers Scratch list receiving the initializers.
          */
-        auto transpileIndexNode(const IndexNode *indexNode) -> std::pair<std::string, std::string>;
+        void transpileDeclarationNode(const FlatAST &ast, NodeId declarationNode, std::vector<PendingCode> &pending,
+                                      std::vector<NodeId> &declaredNames, std::vector<NodeId> &initializers);
         /**
-         * Transpiles an ArrayNode into a string representation.
+         * Transpiles an array node.
          *
-         * @param arrayNode The ArrayNode to transpile.
-         * @return The transpiled string representation of the ArrayNode.
+         * @param ast The flat AST holding the node.
+         * @param arrayNode The array node to transpile.
+         * @param pending The code queued after the node, in order.
          */
-        auto transpileArrayNode(const ArrayNode *arrayNode) -> std::string;
+        void transpileArrayNode(const FlatAST &ast, NodeId arrayNode, std::vector<PendingCode> &pending);
         std::string_view _filename;
         ProjectBuilder _projectBuilder;
-        Parser _parser;
+        std::unique_ptr<CompilationUnit> _ownedUnit;  ///< The unit built from the input, when none was borrowed.
+        CompilationUnit *_unit;                       ///< The unit to transpile.
         fs::path _vnBuildFolder;
         fs::path _vnBuildSrcFolder;
         fs::path _mainOutputFilePath;
     };
 
-    struct TranspileContext {
-        std::ostringstream code;  // Holds the transpiled code.
-        std::string index;        // Holds the current index used in transpiling.
-        std::string arr;          // Holds the array or collection name.
-
-        // Method to set both index and array using std::pair, using std::move for efficiency
-        void setIndexAndArray(const std::pair<std::string, std::string> &idxAndArray) {
-            index = idxAndArray.first;
-            arr = idxAndArray.second;
-        }
-    };
-
 }  // namespace vnd
 
 // NOLINTEND(*-include-cleaner)
@@ -12,6 +12,8 @@ namespace vnd {
     auto timeParser(std::vector<Statement> &ast, vnd::Parser &parser) -> void;
 
     [[nodiscard]] auto timeParse(Parser &parser) -> std::vector<Statement>;
+
+    [[nodiscard]] auto timeParse(CompilationUnit &unit) -> const std::vector<Statement> &;
 }  // namespace vnd
 
 // NOLINTEND(*-const-correctness)
@@ -0,0 +1,275 @@
+// NOLINTBEGIN(*-include-cleaner, *-owning-memory, *-pro-type-reinterpret-cast, *-pro-bounds-pointer-arithmetic)
+#pragma once
+
+#include "headersCore.hpp"
+#include <bit>
+
+DISABLE_WARNINGS_PUSH(26401 26409 26481 26490)
+
+namespace vnd {
+    /**
+     * @brief Monotonic bump allocator: memory is carved out of large chunks and given back all at once.
+     *
+     * Allocating is a pointer bump; deallocating a single block does nothing. Releasing the arena frees its chunks and
+     * runs the destructors of the objects built with create() that need one, so dropping a whole compilation unit
+     * costs one free per chunk instead of one per object.
+     */
+    class Arena {
+    public:
+        static inline constexpr std::size_t defaultChunkSize = 64 * 1024;    ///< Size of the first chunk.
+        static inline constexpr std::size_t maxChunkSize = 4 * 1024 * 1024;  ///< Chunks stop doubling at this size.
+
+        /**
+         * @brief Constructs an empty arena; no memory is taken until the first allocation.
+         * @param chunkSize The size of the first chunk.
+         */
+        explicit Arena(const std::size_t chunkSize = defaultChunkSize) noexcept : _nextChunkSize(std::max(chunkSize, minChunkSize)) {}
+
+        Arena(const Arena &other) = delete;
+        Arena &operator=(const Arena &other) = delete;
+
+        Arena(Arena &&other) noexcept
+          : _chunks(std::exchange(other._chunks, nullptr)), _finalizers(std::exchange(other._finalizers, nullptr)),
+            _cursor(std::exchange(other._cursor, nullptr)), _end(std::exchange(other._end, nullptr)),
+            _nextChunkSize(other._nextChunkSize), _used(std::exchange(other._used, 0)) {}
+
+        Arena &operator=(Arena &&other) noexcept {
+            if(this != &other) {
+                release();
+                _chunks = std::exchange(other._chunks, nullptr);
+                _finalizers = std::exchange(other._finalizers, nullptr);
+                _cursor = std::exchange(other._cursor, nullptr);
+                _end = std::exchange(other._end, nullptr);
+                _nextChunkSize = other._nextChunkSize;
+                _used = std::exchange(other._used, 0);
+            }
+            return *this;
+        }
+
+        ~Arena() { release(); }
+
+        /**
+         * @brief Allocates a block of memory.
+         * @param size The size of the block.
+         * @param alignment The alignment of the block, a power of two.
+         * @return The block, valid until the arena is reset or released.
+         */
+        [[nodiscard]] void *allocate(const std::size_t size, const std::size_t alignment = alignof(std::max_align_t)) {
+            assert(std::has_single_bit(alignment));
+            if(auto *block = bump(size, alignment)) [[likely]] { return block; }
+            grow(size + alignment);
+            return bump(size, alignment);
+        }
+
+        /**
+         * @brief Builds an object in the arena.
+         *
+         * Objects that are not trivially destructible get their destructor run when the arena is reset or
+         * released, in reverse order of construction.
+         * @tparam T The type of the object.
+         * @param args The arguments of the constructor.
+         * @return The object.
+         */
+        template <typename T, typename... Args> [[nodiscard]] T *create(Args &&...args) {
+            if constexpr(std::is_trivially_destructible_v<T>) {
+                return ::new(allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            } else {
+                void *finalizer = allocate(sizeof(Finalizer), alignof(Finalizer));
+                T *object = ::new(allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+                _finalizers = ::new(finalizer)
+                    Finalizer{_finalizers, object, [](void *destroyed) noexcept { std::destroy_at(static_cast<T *>(destroyed)); }};
+                return object;
+            }
+        }
+
+        /**
+         * @brief Destroys every object and rewinds the arena, keeping its newest chunk for the next allocations.
+         */
+        void reset() noexcept {
+            finalize();
+            if(_chunks == nullptr) { return; }
+            freeChunks(_chunks->next);
+            _chunks->next = nullptr;
+            _cursor = _chunks->data();
+            _used = 0;
+        }
+
+        /**
+         * @brief Destroys every object and frees every chunk.
+         */
+        void release() noexcept {
+            finalize();
+            freeChunks(_chunks);
+            _chunks = nullptr;
+            _cursor = nullptr;
+            _end = nullptr;
+            _used = 0;
+        }
+
+        /**
+         * @brief Takes over the chunks and the objects of another arena, which is left empty.
+         *
+         * Nothing is copied: the chunks of the other arena are linked behind the newest chunk of this one, which
+         * keeps serving the next allocations, so blocks handed out by either arena stay valid until this one is reset
+         * or released. Used to gather arenas filled by separate threads.
+         * @param other The arena to take over.
+         */
+        void absorb(Arena &&other) noexcept {
+            if(this == &other || other._chunks == nullptr) { return; }
+            if(_chunks == nullptr) {
+                _chunks = std::exchange(other._chunks, nullptr);
+                _cursor = std::exchange(other._cursor, nullptr);
+                _end = std::exchange(other._end, nullptr);
+            } else {
+                auto *last = other._chunks;
+                while(last->next != nullptr) { last = last->next; }
+                last->next = _chunks->next;
+                _chunks->next = std::exchange(other._chunks, nullptr);
+                other._cursor = nullptr;
+                other._end = nullptr;
+            }
+            if(other._finalizers != nullptr) {
+                auto *last = other._finalizers;
+                while(last->next != nullptr) { last = last->next; }
+                last->next = _finalizers;
+                _finalizers = std::exchange(other._finalizers, nullptr);
+            }
+            _used += std::exchange(other._used, 0);
+        }
+
+        /**
+         * @brief Gets the number of chunks the arena holds.
+         * @return The number of chunks.
+         */
+        [[nodiscard]] std::size_t chunkCount() const noexcept {
+            std::size_t count = 0;
+            for(const auto *chunk = _chunks; chunk != nullptr; chunk = chunk->next) { ++count; }
+            return count;
+        }
+
+        /**
+         * @brief Gets the bytes handed out since the arena was last reset, padding included.
+         * @return The number of bytes.
+         */
+        [[nodiscard]] std::size_t bytesUsed() const noexcept { return _used; }
+
+    private:
+        static inline constexpr std::size_t minChunkSize = 256;
+
+        /**
+         * @brief Header at the start of every chunk; the usable bytes follow it.
+         */
+        struct alignas(std::max_align_t) Chunk {
+            Chunk *next;       ///< The chunk allocated before this one.
+            std::size_t size;  ///< The usable bytes of the chunk.
+
+            [[nodiscard]] std::byte *data() noexcept { return reinterpret_cast<std::byte *>(this + 1); }
+        };
+
+        /**
+         * @brief Destructor to run for an object built with create(), linked in construction order.
+         */
+        struct Finalizer {
+            Finalizer *next;                   ///< The finalizer registered before this one.
+            void *object;                      ///< The object to destroy.
+            void (*destroy)(void *) noexcept;  ///< Destroys the object.
+        };
+
+        [[nodiscard]] void *bump(const std::size_t size, const std::size_t alignment) noexcept {
+            if(_cursor == nullptr) { return nullptr; }
+            const auto address = reinterpret_cast<std::uintptr_t>(_cursor);
+            const auto padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+            if(C_ST(_end - _cursor) < padding + size) { return nullptr; }
+            auto *block = _cursor + padding;
+            _cursor = block + size;
+            _used += padding + size;
+            return block;
+        }
+
+        void grow(const std::size_t minimum) {
+            const auto size = std::max(_nextChunkSize, minimum);
+            auto *chunk = ::new(::operator new(sizeof(Chunk) + size)) Chunk{_chunks, size};
+            _chunks = chunk;
+            _cursor = chunk->data();
+            _end = _cursor + size;
+            _nextChunkSize = std::min(_nextChunkSize * 2, std::max(maxChunkSize, _nextChunkSize));
+        }
+
+        void finalize() noexcept {
+            for(auto *finalizer = _finalizers; finalizer != nullptr; finalizer = finalizer->next) { finalizer->destroy(finalizer->object); }
+            _finalizers = nullptr;
+        }
+
+        static void freeChunks(Chunk *chunk) noexcept {
+            while(chunk != nullptr) { ::operator delete(std::exchange(chunk, chunk->next)); }
+        }
+
+        Chunk *_chunks{nullptr};          ///< The newest chunk, linked to the older ones.
+        Finalizer *_finalizers{nullptr};  ///< The newest finalizer, linked to the older ones.
+        std::byte *_cursor{nullptr};      ///< The first free byte of the newest chunk.
+        std::byte *_end{nullptr};         ///< One past the last byte of the newest chunk.
+        std::size_t _nextChunkSize;       ///< The size of the next chunk.
+        std::size_t _used{0};             ///< The bytes handed out since the last reset.
+    };
+
+    /**
+     * @brief std::pmr::memory_resource backed by an Arena, for the standard pmr containers.
+     *
+     * Deallocation is a no-op: the memory comes back when the arena is reset or released.
+     */
+    class ArenaResource final : public std::pmr::memory_resource {
+    public:
+        /**
+         * @brief Constructs the resource.
+         * @param arena The arena to allocate from; it must outlive the resource and everything allocated from it.
+         */
+        explicit ArenaResource(Arena &arena) noexcept : _arena(&arena) {}
+
+        /**
+         * @brief Gets the arena the resource allocates from.
+         * @return The arena.
+         */
+        [[nodiscard]] Arena &arena() const noexcept { return *_arena; }
+
+    private:
+        void *do_allocate(const std::size_t bytes, const std::size_t alignment) override { return _arena->allocate(bytes, alignment); }
+        void do_deallocate(void * /*block*/, std::size_t /*bytes*/, std::size_t /*alignment*/) noexcept override {}
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+        Arena *_arena;  ///< The arena to allocate from.
+    };
+
+    /**
+     * @brief Standard allocator backed by an Arena, for containers that do not take a memory_resource.
+     * @tparam T The type of the allocated elements.
+     */
+    template <typename T> class ArenaAllocator {
+    public:
+        using value_type = T;
+
+        /**
+         * @brief Constructs the allocator.
+         * @param arena The arena to allocate from; it must outlive everything allocated from it.
+         */
+        explicit ArenaAllocator(Arena &arena) noexcept : _arena(&arena) {}
+
+        template <typename U> explicit(false) ArenaAllocator(const ArenaAllocator<U> &other) noexcept : _arena(&other.arena()) {}
+
+        [[nodiscard]] T *allocate(const std::size_t count) { return static_cast<T *>(_arena->allocate(count * sizeof(T), alignof(T))); }
+        void deallocate(T * /*block*/, std::size_t /*count*/) noexcept {}
+
+        /**
+         * @brief Gets the arena the allocator allocates from.
+         * @return The arena.
+         */
+        [[nodiscard]] Arena &arena() const noexcept { return *_arena; }
+
+        template <typename U> bool operator==(const ArenaAllocator<U> &other) const noexcept { return _arena == &other.arena(); }
+
+    private:
+        Arena *_arena;  ///< The arena to allocate from.
+    };
+}  // namespace vnd
+
+DISABLE_WARNINGS_POP()
+// NOLINTEND(*-include-cleaner, *-owning-memory, *-pro-type-reinterpret-cast, *-pro-bounds-pointer-arithmetic)
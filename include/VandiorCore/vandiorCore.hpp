@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "Arena.hpp"
 #include "FileReader.hpp"
 #include "Log.hpp"
 #include "headersCore.hpp"
\ No newline at end of file
@@ -13,19 +13,16 @@ DISABLE_WARNINGS_PUSH(
 DISABLE_WARNINGS_POP()
 namespace vnd {
     // NOLINTNEXTLINE(*-use-anonymous-namespace)
-    static auto timeTokenizer(Tokenizer &tokenizer, std::vector<TokenVec> &tokens) -> void {
-        tokens.clear();
+    static auto timeTokenizer(CompilationUnit &unit) -> const TokenStream & {
 #ifdef INDEPT
         const AutoTimer timer("tokenization");
 #endif
-        tokens = tokenizer.tokenize();
+        return unit.tokens();
     }
     // NOLINTNEXTLINE(*-use-anonymous-namespace)
-    void count_total_num_tokens(const std::vector<vnd::TokenVec> &tokens) {
+    void count_total_num_tokens(const vnd::TokenStream &tokens) {
         vnd::AutoTimer const timer("Counting total number of tokens");
-        const std::size_t totalTokenSize = std::accumulate(tokens.begin(), tokens.end(), std::size_t{0},
-                                                           [](std::size_t sum, const vnd::TokenVec &inner) { return sum + inner.size(); });
-        LINFO("num tokens {}", totalTokenSize);
+        LINFO("num tokens {}", tokens.tokenCount());
     }
 
 }  // namespace vnd
@@ -59,11 +56,13 @@ auto main(int argc, const char *const argv[]) -> int {
         bool run = false;
         bool clean = false;
         bool create_cmake = false;
+        bool split = false;
         app.add_flag("--version, -v", show_version, "Show version information");
         app.add_flag("--compile, -c", compile, "Compile the resulting code");
         app.add_flag("--run, -r", run, "Compile the resulting code and execute it");
         app.add_flag("--clean, -x", clean, "Clean before building");
         app.add_flag("--cmake, -m", create_cmake, "Create a CMakeLists.txt file");
+        app.add_flag("--split, -s", split, "Transpile every fun into its own translation unit");
         CLI11_PARSE(app, argc, argv)
         if(show_version) {
             LINFO("{}", Vandior::cmake::project_version);
@@ -89,15 +88,10 @@ auto main(int argc, const char *const argv[]) -> int {
 #endif
             }
         }
-        const auto str = vnd::readFromFile(porfilename);
-        const std::string_view code(str);
-        vnd::Tokenizer tokenizer{code, porfilename};
-        std::vector<vnd::TokenVec> tokens;
-        vnd::timeTokenizer(tokenizer, tokens);
-        LINFO("num tokens {}", tokens.size());
-        LINFO("Input:\n{}", code);
-        vnd::Parser parser{code, "input.vn"};
-        for(const auto progrmamAST = vnd::timeParse(parser); const auto &statement : progrmamAST) {
+        vnd::CompilationUnit unit{vnd::readFromFile(porfilename), porfilename};
+        LINFO("num tokens {}", vnd::timeTokenizer(unit).tokenCount());
+        LINFO("Input:\n{}", unit.source());
+        for(const auto &statement : vnd::timeParse(unit)) {
             const auto &node = statement.get_root();
             const auto &token = statement.get_token();
             if(token.getType() == vnd::TokenType::UNKNOWN) { LINFO("the statement is not generated by any token"); }
@@ -108,8 +102,18 @@ auto main(int argc, const char *const argv[]) -> int {
                 LINFO("EMPTY STATMENT generated from {}", token.compat_to_string());
             }
         }
-        vnd::Transpiler transpiler{code, porfilename, create_cmake};
-        LINFO("transpiled code: \n{}", transpiler.transpile());
+        vnd::Transpiler transpiler{unit, create_cmake};
+        if(split) {
+            for(const auto &file : transpiler.transpileUnits()) {
+                if(file.reused) {
+                    LINFO("reused {}: its source did not change", file.name);
+                } else {
+                    LINFO("transpiled {}: \n{}", file.name, file.code);
+                }
+            }
+        } else {
+            LINFO("transpiled code: \n{}", transpiler.transpile());
+        }
     } catch(const std::exception &e) {
         // Handle any other types of exceptions
         LERROR("Unhandled exception in main: {}", e.what());
@@ -0,0 +1,357 @@
+// NOLINTBEGIN(*-include-cleaner, *-magic-numbers, *-avoid-magic-numbers, *-pro-bounds-pointer-arithmetic, *-reinterpret-cast)
+#include "Vandior/lexer/SimdScanner.hpp"
+#include "Vandior/lexer/TokenizerUtility.hpp"
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define VND_SIMD_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define VND_TARGET_AVX2
+#else
+#define VND_TARGET_AVX2 __attribute__((target("avx2,popcnt,bmi")))
+#endif
+#if defined(VANDIOR_SIMD_SSE2) || defined(VANDIOR_SIMD_AVX2)
+#include <immintrin.h>
+#endif
+#endif
+
+DISABLE_WARNINGS_PUSH(26446 26481 26490)
+namespace vnd {
+    namespace {
+        /**
+         * @brief What a kernel is looking for; also decides whether line breaks are counted.
+         */
+        enum class ScanKind : std::uint8_t { Newline, BlockComment, Quote, Whitespace, Identifier };
+
+        [[nodiscard]] constexpr bool countsNewlines(const ScanKind kind) noexcept {
+            return kind == ScanKind::BlockComment || kind == ScanKind::Quote || kind == ScanKind::Whitespace;
+        }
+
+        template <ScanKind K> [[nodiscard]] constexpr bool isStop(const char cha) noexcept {
+            using enum ScanKind;
+            if constexpr(K == Newline) {
+                return cha == NL;
+            } else if constexpr(K == BlockComment) {
+                return cha == starcr;
+            } else if constexpr(K == Quote) {
+                return cha == '"';
+            } else if constexpr(K == Whitespace) {
+                return !TokenizerUtility::hasTrait(cha, TRAIT_SPACE);
+            } else {
+                return !TokenizerUtility::hasTrait(cha, TRAIT_IDENT);
+            }
+        }
+
+        /**
+         * @brief Checks if the stop candidate at pos really ends the scan ('*' must be followed by '/').
+         */
+        template <ScanKind K> [[nodiscard]] constexpr bool confirmStop(const std::string_view input, const std::size_t pos) noexcept {
+            if constexpr(K == ScanKind::BlockComment) {
+                return pos + 1 < input.size() && input[pos + 1] == slashcr;
+            } else {
+                return true;
+            }
+        }
+
+        template <ScanKind K> [[nodiscard]] ScanResult scanScalar(const std::string_view input, std::size_t pos, ScanResult result) noexcept {
+            const auto size = input.size();
+            for(; pos < size; ++pos) {
+                const char cha = input[pos];
+                if(isStop<K>(cha) && confirmStop<K>(input, pos)) { break; }
+                if constexpr(countsNewlines(K)) {
+                    if(cha == NL || (cha == CR && (pos + 1 >= size || input[pos + 1] != NL))) [[unlikely]] {
+                        ++result.newlines;
+                        result.lineStart = pos + 1;
+                    }
+                }
+            }
+            result.position = pos;
+            return result;
+        }
+
+        /**
+         * @brief Reports the line breaks from pos on, one at a time, as single-bit masks.
+         * @param sink Called with (blockStart, mask); bit i of mask marks a line break at blockStart + i.
+         */
+        template <typename Sink> void lineBreaksScalar(const std::string_view input, std::size_t pos, Sink &sink) {
+            const auto size = input.size();
+            for(; pos < size; ++pos) {
+                const char cha = input[pos];
+                if(cha == NL || (cha == CR && (pos + 1 >= size || input[pos + 1] != NL))) { sink(pos, 1U); }
+            }
+        }
+
+#if defined(VND_SIMD_X86) && (defined(VANDIOR_SIMD_SSE2) || defined(VANDIOR_SIMD_AVX2))
+        /**
+         * @brief Accumulates the line breaks of one block that come before the first stop bit.
+         * @param lfMask Bits of the '\n' bytes in the block.
+         * @param crMask Bits of the '\r' bytes in the block.
+         * @param nextLfMask Bits of the '\n' bytes in the block shifted by one byte.
+         * @param stopMask Bits of the stop candidates.
+         */
+        void countBlockNewlines(ScanResult &result, const std::size_t blockStart, std::uint32_t lfMask, std::uint32_t crMask,
+                                const std::uint32_t nextLfMask, const std::uint32_t stopMask) noexcept {
+            if(stopMask != 0) {
+                const auto before = (stopMask & (~stopMask + 1U)) - 1U;
+                lfMask &= before;
+                crMask &= before;
+            }
+            crMask &= ~nextLfMask;
+            const auto breaks = lfMask | crMask;
+            if(breaks == 0) [[likely]] { return; }
+            result.newlines += C_ST(std::popcount(lfMask) + std::popcount(crMask));
+            result.lineStart = blockStart + 32U - C_ST(std::countl_zero(breaks));
+        }
+#endif
+
+#if defined(VND_SIMD_X86) && defined(VANDIOR_SIMD_SSE2)
+        [[nodiscard]] inline std::uint32_t sse2Mask(const __m128i cmp) noexcept { return C_UI32T(_mm_movemask_epi8(cmp)); }
+
+        [[nodiscard]] inline __m128i sse2InRange(const __m128i block, const char low, const char high) noexcept {
+            const __m128i shifted = _mm_sub_epi8(block, _mm_set1_epi8(low));
+            return _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(C_C(high - low))), shifted);
+        }
+
+        template <ScanKind K> [[nodiscard]] std::uint32_t sse2StopMask(const __m128i block) noexcept {
+            using enum ScanKind;
+            if constexpr(K == Newline) {
+                return sse2Mask(_mm_cmpeq_epi8(block, _mm_set1_epi8(NL)));
+            } else if constexpr(K == BlockComment) {
+                return sse2Mask(_mm_cmpeq_epi8(block, _mm_set1_epi8(starcr)));
+            } else if constexpr(K == Quote) {
+                return sse2Mask(_mm_cmpeq_epi8(block, _mm_set1_epi8('"')));
+            } else if constexpr(K == Whitespace) {
+                const __m128i space = _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')), sse2InRange(block, CTAB, CR));
+                return ~sse2Mask(space) & 0xFFFFU;
+            } else {
+                const __m128i lower = _mm_or_si128(block, _mm_set1_epi8(0x20));
+                const __m128i ident = _mm_or_si128(_mm_or_si128(sse2InRange(lower, 'a', 'z'), sse2InRange(block, zerocr, '9')),
+                                                   _mm_cmpeq_epi8(block, _mm_set1_epi8(underscore)));
+                return ~sse2Mask(ident) & 0xFFFFU;
+            }
+        }
+
+        template <ScanKind K> [[nodiscard]] ScanResult scanSse2(const std::string_view input, std::size_t pos) noexcept {
+            constexpr std::size_t width = 16;
+            const auto *data = input.data();
+            ScanResult result{pos, 0, std::string_view::npos};
+            // One extra byte is needed to pair '\r' with a following '\n'.
+            while(pos + width + 1 <= input.size()) {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos));
+                const auto stop = sse2StopMask<K>(block);
+                if constexpr(countsNewlines(K)) {
+                    const __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos + 1));
+                    countBlockNewlines(result, pos, sse2Mask(_mm_cmpeq_epi8(block, _mm_set1_epi8(NL))),
+                                       sse2Mask(_mm_cmpeq_epi8(block, _mm_set1_epi8(CR))), sse2Mask(_mm_cmpeq_epi8(next, _mm_set1_epi8(NL))),
+                                       stop);
+                }
+                if(stop != 0) {
+                    const auto hit = pos + C_ST(std::countr_zero(stop));
+                    if(confirmStop<K>(input, hit)) {
+                        result.position = hit;
+                        return result;
+                    }
+                    // False '*' candidate: resume right after it, the newlines before it are already counted.
+                    pos = hit + 1;
+                    continue;
+                }
+                pos += width;
+            }
+            return scanScalar<K>(input, pos, result);
+        }
+
+        template <typename Sink> void lineBreaksSse2(const std::string_view input, Sink &sink) {
+            constexpr std::size_t width = 16;
+            const auto *data = input.data();
+            std::size_t pos = 0;
+            while(pos + width + 1 <= input.size()) {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos));
+                const __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos + 1));
+                const auto lfMask = sse2Mask(_mm_cmpeq_epi8(block, _mm_set1_epi8(NL)));
+                const auto crMask = sse2Mask(_mm_cmpeq_epi8(block, _mm_set1_epi8(CR))) & ~sse2Mask(_mm_cmpeq_epi8(next, _mm_set1_epi8(NL)));
+                if(const auto breaks = lfMask | crMask; breaks != 0) { sink(pos, breaks); }
+                pos += width;
+            }
+            lineBreaksScalar(input, pos, sink);
+        }
+#endif
+
+#if defined(VND_SIMD_X86) && defined(VANDIOR_SIMD_AVX2)
+        [[nodiscard]] VND_TARGET_AVX2 inline std::uint32_t avx2Mask(const __m256i cmp) noexcept {
+            return C_UI32T(_mm256_movemask_epi8(cmp));
+        }
+
+        [[nodiscard]] VND_TARGET_AVX2 inline __m256i avx2InRange(const __m256i block, const char low, const char high) noexcept {
+            const __m256i shifted = _mm256_sub_epi8(block, _mm256_set1_epi8(low));
+            return _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(C_C(high - low))), shifted);
+        }
+
+        template <ScanKind K> [[nodiscard]] VND_TARGET_AVX2 std::uint32_t avx2StopMask(const __m256i block) noexcept {
+            using enum ScanKind;
+            if constexpr(K == Newline) {
+                return avx2Mask(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(NL)));
+            } else if constexpr(K == BlockComment) {
+                return avx2Mask(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(starcr)));
+            } else if constexpr(K == Quote) {
+                return avx2Mask(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('"')));
+            } else if constexpr(K == Whitespace) {
+                const __m256i space = _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(' ')), avx2InRange(block, CTAB, CR));
+                return ~avx2Mask(space);
+            } else {
+                const __m256i lower = _mm256_or_si256(block, _mm256_set1_epi8(0x20));
+                const __m256i ident = _mm256_or_si256(_mm256_or_si256(avx2InRange(lower, 'a', 'z'), avx2InRange(block, zerocr, '9')),
+                                                      _mm256_cmpeq_epi8(block, _mm256_set1_epi8(underscore)));
+                return ~avx2Mask(ident);
+            }
+        }
+
+        template <ScanKind K> [[nodiscard]] VND_TARGET_AVX2 ScanResult scanAvx2(const std::string_view input, std::size_t pos) noexcept {
+            constexpr std::size_t width = 32;
+            const auto *data = input.data();
+            ScanResult result{pos, 0, std::string_view::npos};
+            while(pos + width + 1 <= input.size()) {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + pos));
+                const auto stop = avx2StopMask<K>(block);
+                if constexpr(countsNewlines(K)) {
+                    const __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + pos + 1));
+                    countBlockNewlines(result, pos, avx2Mask(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(NL))),
+                                       avx2Mask(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(CR))),
+                                       avx2Mask(_mm256_cmpeq_epi8(next, _mm256_set1_epi8(NL))), stop);
+                }
+                if(stop != 0) {
+                    const auto hit = pos + C_ST(std::countr_zero(stop));
+                    if(confirmStop<K>(input, hit)) {
+                        result.position = hit;
+                        return result;
+                    }
+                    pos = hit + 1;
+                    continue;
+                }
+                pos += width;
+            }
+            return scanScalar<K>(input, pos, result);
+        }
+        template <typename Sink> VND_TARGET_AVX2 void lineBreaksAvx2(const std::string_view input, Sink &sink) {
+            constexpr std::size_t width = 32;
+            const auto *data = input.data();
+            std::size_t pos = 0;
+            while(pos + width + 1 <= input.size()) {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + pos));
+                const __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + pos + 1));
+                const auto lfMask = avx2Mask(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(NL)));
+                const auto crMask = avx2Mask(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(CR))) &
+                                    ~avx2Mask(_mm256_cmpeq_epi8(next, _mm256_set1_epi8(NL)));
+                if(const auto breaks = lfMask | crMask; breaks != 0) { sink(pos, breaks); }
+                pos += width;
+            }
+            lineBreaksScalar(input, pos, sink);
+        }
+#endif
+
+        [[nodiscard]] bool cpuSupportsAvx2() noexcept {
+#if defined(VND_SIMD_X86) && defined(VANDIOR_SIMD_AVX2)
+#if defined(_MSC_VER) && !defined(__clang__)
+            std::array<int, 4> info{};
+            __cpuid(info.data(), 1);
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            if(!osxsave || (_xgetbv(0) & 0x6U) != 0x6U) { return false; }
+            __cpuidex(info.data(), 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") != 0;
+#endif
+#else
+            return false;
+#endif
+        }
+
+        std::atomic<SimdLevel> &activeLevel() noexcept {
+            static std::atomic<SimdLevel> level{SimdScanner::detectLevel()};
+            return level;
+        }
+
+        template <ScanKind K> [[nodiscard]] ScanResult dispatch(const std::string_view input, const std::size_t pos) noexcept {
+            switch(activeLevel().load(std::memory_order_relaxed)) {
+#if defined(VND_SIMD_X86) && defined(VANDIOR_SIMD_AVX2)
+            case SimdLevel::AVX2:
+                return scanAvx2<K>(input, pos);
+#endif
+#if defined(VND_SIMD_X86) && defined(VANDIOR_SIMD_SSE2)
+            case SimdLevel::SSE2:
+                return scanSse2<K>(input, pos);
+#endif
+            default:
+                return scanScalar<K>(input, pos, {pos, 0, std::string_view::npos});
+            }
+        }
+
+        template <typename Sink> void forEachLineBreak(const std::string_view input, Sink &&sink) {
+            switch(activeLevel().load(std::memory_order_relaxed)) {
+#if defined(VND_SIMD_X86) && defined(VANDIOR_SIMD_AVX2)
+            case SimdLevel::AVX2:
+                lineBreaksAvx2(input, sink);
+                return;
+#endif
+#if defined(VND_SIMD_X86) && defined(VANDIOR_SIMD_SSE2)
+            case SimdLevel::SSE2:
+                lineBreaksSse2(input, sink);
+                return;
+#endif
+            default:
+                lineBreaksScalar(input, 0, sink);
+            }
+        }
+    }  // namespace
+
+    SimdLevel SimdScanner::detectLevel() noexcept {
+        if(cpuSupportsAvx2()) { return SimdLevel::AVX2; }
+#if defined(VND_SIMD_X86) && defined(VANDIOR_SIMD_SSE2)
+        return SimdLevel::SSE2;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+
+    SimdLevel SimdScanner::level() noexcept { return activeLevel().load(std::memory_order_relaxed); }
+
+    void SimdScanner::setLevel(const SimdLevel level) noexcept {
+        activeLevel().store(std::min(level, detectLevel()), std::memory_order_relaxed);
+    }
+
+    std::size_t SimdScanner::findNewline(const std::string_view input, const std::size_t pos) noexcept {
+        return dispatch<ScanKind::Newline>(input, pos).position;
+    }
+
+    ScanResult SimdScanner::skipBlockComment(const std::string_view input, const std::size_t pos) noexcept {
+        return dispatch<ScanKind::BlockComment>(input, pos);
+    }
+
+    ScanResult SimdScanner::skipString(const std::string_view input, const std::size_t pos) noexcept {
+        return dispatch<ScanKind::Quote>(input, pos);
+    }
+
+    ScanResult SimdScanner::skipWhitespace(const std::string_view input, const std::size_t pos) noexcept {
+        return dispatch<ScanKind::Whitespace>(input, pos);
+    }
+
+    std::size_t SimdScanner::skipIdentifier(const std::string_view input, const std::size_t pos) noexcept {
+        return dispatch<ScanKind::Identifier>(input, pos).position;
+    }
+
+    std::vector<std::uint32_t> SimdScanner::lineStarts(const std::string_view input) {
+        // Count first so the table is allocated once, then fill it.
+        std::size_t count = 0;
+        forEachLineBreak(input, [&count](const std::size_t, const std::uint32_t mask) { count += C_ST(std::popcount(mask)); });
+        std::vector<std::uint32_t> starts;
+        starts.reserve(count + 1);
+        starts.push_back(0);
+        forEachLineBreak(input, [&starts](const std::size_t blockStart, std::uint32_t mask) {
+            for(; mask != 0; mask &= mask - 1U) { starts.push_back(C_UI32T(blockStart + C_ST(std::countr_zero(mask)) + 1)); }
+        });
+        return starts;
+    }
+}  // namespace vnd
+DISABLE_WARNINGS_POP()
+// NOLINTEND(*-include-cleaner, *-magic-numbers, *-avoid-magic-numbers, *-pro-bounds-pointer-arithmetic, *-reinterpret-cast)
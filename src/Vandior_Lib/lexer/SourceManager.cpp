@@ -0,0 +1,225 @@
+#include "Vandior/lexer/SourceManager.hpp"
+#include "Vandior/lexer/SimdScanner.hpp"
+#include "Vandior/lexer/SourceEdit.hpp"
+#include <bit>
+#include <cassert>
+#include <mutex>
+#include <unordered_map>
+
+// NOLINTBEGIN(*-include-cleaner, *-avoid-magic-numbers, *-magic-numbers)
+namespace vnd {
+    namespace {
+        // Identity of a synthetic entry: the views themselves, not their contents, plus the fixed location.
+        struct SyntheticKey {
+            const char *value;
+            std::size_t valueSize;
+            const char *fileName;
+            std::size_t fileNameSize;
+            std::size_t line;
+            std::size_t column;
+
+            bool operator==(const SyntheticKey &other) const noexcept = default;
+        };
+
+        struct SyntheticKeyHash {
+            std::size_t operator()(const SyntheticKey &key) const noexcept {
+                std::size_t seed = std::hash<const char *>{}(key.value);
+                const auto combine = [&seed](const std::size_t value) { seed ^= value + 0x9E3779B97F4A7C15ULL + (seed << 6) + (seed >> 2); };
+                combine(key.valueSize);
+                combine(std::hash<const char *>{}(key.fileName));
+                combine(key.fileNameSize);
+                combine(key.line);
+                combine(key.column);
+                return seed;
+            }
+        };
+
+        /**
+         * Entries live in segments of doubling size that are never moved, so a reader can index an entry without
+         * taking the lock while another thread registers a new one.
+         *
+         * A FileId is the index of its slot plus, in the top bits, the generation of the slot: releasing an entry bumps
+         * the generation, so the id of a reused slot never matches the ids handed out before, and a token read after
+         * its entry was released fails an assertion instead of reading the text of another file. A slot whose
+         * generation runs out is retired.
+         */
+        class SourceTable {
+        public:
+            static inline constexpr std::size_t firstSegmentSize = 64;
+            static inline constexpr std::size_t segmentCount = 19;
+            static inline constexpr unsigned indexBits = 24;
+            static inline constexpr FileId indexMask = (FileId{1} << indexBits) - 1;
+            static inline constexpr std::uint32_t generationCount = std::uint32_t{1} << (32 - indexBits);
+
+            SourceTable() { (void)append(SourceFile{"unknown"sv, ""sv, {}, 0, 0}); }
+
+            FileId append(SourceFile &&file) {
+                const std::scoped_lock lock(mutex);
+                return appendLocked(std::move(file));
+            }
+
+            FileId synthetic(const std::string_view value, const CodeSourceLocation &location) {
+                const auto fileName = location.getFileName();
+                const SyntheticKey key{value.data(), value.size(), fileName.data(), fileName.size(), location.getLine(), location.getColumn()};
+                // The lookup and the insertion share the lock, so two threads cannot both register the same value.
+                const std::scoped_lock lock(mutex);
+                if(const auto found = synthetics.find(key); found != synthetics.end()) { return found->second; }
+                const auto id = appendLocked(SourceFile{fileName, value, {}, location.getLine(), location.getColumn()});
+                synthetics.emplace(key, id);
+                return id;
+            }
+
+            void release(const FileId fileId) {
+                const std::scoped_lock lock(mutex);
+                auto &entry = slot(fileId);
+                entry.file = SourceFile{};
+                const auto generation = entry.generation.load(std::memory_order_relaxed) + 1;
+                entry.generation.store(generation, std::memory_order_release);
+                if(generation < generationCount) {
+                    released.push_back(fileId & indexMask);
+                } else {
+                    ++retired;
+                }
+            }
+
+            // Only the owner of a file entry changes it, so the entry needs no lock, like the reads.
+            [[nodiscard]] SourceFile &file(const FileId fileId) noexcept { return slot(fileId).file; }
+
+            [[nodiscard]] std::size_t size() {
+                const std::scoped_lock lock(mutex);
+                return count - released.size() - retired;
+            }
+
+            [[nodiscard]] const SourceFile &get(const FileId fileId) const noexcept {
+                const auto &entry = slot(fileId);
+                assert(entry.generation.load(std::memory_order_acquire) == fileId >> indexBits && "the SourceManager entry was released");
+                return entry.file;
+            }
+
+        private:
+            struct Slot {
+                SourceFile file;
+                std::atomic<std::uint32_t> generation{0};
+            };
+
+            std::mutex mutex;
+            std::size_t count{0};
+            std::size_t retired{0};
+            std::array<std::unique_ptr<Slot[]>, segmentCount> storage{};
+            std::array<std::atomic<Slot *>, segmentCount> segments{};
+            std::unordered_map<SyntheticKey, FileId, SyntheticKeyHash> synthetics;
+            std::vector<FileId> released;  // Indices of the released slots, handed out again before the table grows.
+
+            FileId appendLocked(SourceFile &&file) {
+                if(!released.empty()) {
+                    const auto index = released.back();
+                    released.pop_back();
+                    auto &entry = slot(index);
+                    entry.file = std::move(file);
+                    return entry.generation.load(std::memory_order_relaxed) << indexBits | index;
+                }
+                if(count > indexMask) [[unlikely]] { throw std::length_error("SourceManager: too many sources"); }
+                const auto id = C_UI32T(count);
+                const auto [segment, index] = split(id);
+                if(storage.at(segment) == nullptr) {
+                    storage.at(segment) = std::make_unique<Slot[]>(firstSegmentSize << segment);
+                    segments.at(segment).store(storage.at(segment).get(), std::memory_order_release);
+                }
+                storage.at(segment)[index].file = std::move(file);
+                ++count;
+                return id;
+            }
+
+            [[nodiscard]] Slot &slot(const FileId fileId) const noexcept {
+                const auto [segment, index] = split(fileId & indexMask);
+                return segments[segment].load(std::memory_order_acquire)[index];
+            }
+
+            // Segment s holds the indices in [firstSegmentSize * (2^s - 1), firstSegmentSize * (2^(s+1) - 1)).
+            [[nodiscard]] static std::pair<std::size_t, std::size_t> split(const FileId index) noexcept {
+                const auto bucket = C_ST(index) / firstSegmentSize + 1;
+                const auto segment = C_ST(std::bit_width(bucket)) - 1;
+                return {segment, C_ST(index) - firstSegmentSize * ((std::size_t{1} << segment) - 1)};
+            }
+        };
+
+        SourceTable &table() {
+            static SourceTable instance;
+            return instance;
+        }
+    }  // namespace
+
+    std::size_t SourceFile::lineOf(const std::size_t offset) const noexcept {
+        const auto next = std::ranges::upper_bound(lineStarts, offset, std::less{}, [](const std::uint32_t start) { return C_ST(start); });
+        return C_ST(std::distance(lineStarts.begin(), next));
+    }
+
+    std::string_view SourceFile::lineText(const std::size_t lineNumber) const noexcept {
+        const std::size_t start = lineStarts[lineNumber - 1];
+        auto end = lineNumber < lineStarts.size() ? C_ST(lineStarts[lineNumber]) : text.size();
+        // Drop the line break, which is either '\n', '\r' or "\r\n".
+        if(end > start && text[end - 1] == NL) { --end; }
+        if(end > start && text[end - 1] == CR) { --end; }
+        return text.substr(start, end - start);
+    }
+
+    CodeSourceLocation SourceFile::locate(const std::uint32_t offset) const noexcept {
+        if(isSynthetic()) { return {fileName, line, column}; }
+        const auto lineNumber = lineOf(offset);
+        return {fileName, lineNumber, C_ST(offset - lineStarts[lineNumber - 1]) + 1};
+    }
+
+    FileId SourceManager::addFile(const std::string_view fileName, const std::string_view text) {
+        if(text.size() > std::numeric_limits<std::uint32_t>::max()) [[unlikely]] {
+            throw std::length_error("SourceManager: source larger than 4 GiB");
+        }
+        return table().append(SourceFile{fileName, text, SimdScanner::lineStarts(text), 0, 0});
+    }
+
+    void SourceManager::rebind(const FileId fileId, const std::string_view fileName, const std::string_view text) {
+        if(text.size() > std::numeric_limits<std::uint32_t>::max()) [[unlikely]] {
+            throw std::length_error("SourceManager: source larger than 4 GiB");
+        }
+        auto &file = table().file(fileId);
+        file.lineStarts = SimdScanner::lineStarts(text);
+        file.fileName = fileName;
+        file.text = text;
+    }
+
+    void SourceManager::rebind(const FileId fileId, const std::string_view text, const SourceEdit &edit) {
+        if(text.size() > std::numeric_limits<std::uint32_t>::max()) [[unlikely]] {
+            throw std::length_error("SourceManager: source larger than 4 GiB");
+        }
+        auto &file = table().file(fileId);
+        auto &starts = file.lineStarts;
+        const auto byValue = [](const std::uint32_t start) { return C_ST(start); };
+        // A line start depends on the byte before it and on its own byte, as "\r\n" is a single break: the starts up to
+        // the line holding the byte before the edit stay, the ones up to the byte after the replacement are scanned
+        // again and the ones past the replaced bytes only move.
+        const auto kept = file.lineOf(edit.begin > 0 ? edit.begin - 1 : 0);
+        const auto from = C_ST(starts[kept - 1]);
+        const auto moved = C_ST(std::ranges::upper_bound(starts, edit.end, std::less{}, byValue) - starts.begin());
+        const auto editEnd = edit.begin + edit.replacement.size();
+        const auto scanned = SimdScanner::lineStarts(text.substr(from, std::min(editEnd + 1, text.size()) - from));
+        const auto last = std::ranges::upper_bound(scanned, editEnd - from, std::less{}, byValue);
+        std::vector<std::uint32_t> patched;
+        patched.reserve(C_ST(last - scanned.begin()));
+        for(auto start = std::next(scanned.begin()); start != last; ++start) { patched.push_back(C_UI32T(C_ST(*start) + from)); }
+        const auto delta = edit.shift();
+        for(auto index = moved; index < starts.size(); ++index) { starts[index] = C_UI32T(C_I64T(starts[index]) + delta); }
+        starts.erase(std::next(starts.begin(), C_PTRDIFT(kept)), std::next(starts.begin(), C_PTRDIFT(moved)));
+        starts.insert(std::next(starts.begin(), C_PTRDIFT(kept)), patched.begin(), patched.end());
+        file.text = text;
+    }
+
+    void SourceManager::release(const FileId fileId) { table().release(fileId); }
+
+    std::size_t SourceManager::size() { return table().size(); }
+
+    FileId SourceManager::addSynthetic(const std::string_view value, const CodeSourceLocation &location) {
+        return table().synthetic(value, location);
+    }
+
+    const SourceFile &SourceManager::get(const FileId fileId) noexcept { return table().get(fileId); }
+}  // namespace vnd
+// NOLINTEND(*-include-cleaner, *-avoid-magic-numbers, *-magic-numbers)
@@ -2,13 +2,13 @@
 // NOLINTBEGIN(*-include-cleaner)
 namespace vnd {
     std::string Token::to_string() const {
-        if(_type == eofTokenType) { return FORMAT("(type: {}, source location:{})", _type, _sourceLocation); }
-        return FORMAT("(type: {}, value: '{}', source location:{})", _type, _value, _sourceLocation);
+        if(_type == eofTokenType) { return FORMAT("(type: {}, source location:{})", _type, getSourceLocation()); }
+        return FORMAT("(type: {}, value: '{}', source location:{})", _type, getValue(), getSourceLocation());
     }
 
     std::string Token::compat_to_string() const {
-        if(_type == eofTokenType) { return FORMAT("(typ: {}, sl:{})", comp_tokType(_type), _sourceLocation.compat_to_string()); }
-        return FORMAT("(typ: {}, val: '{}', sl:{})", comp_tokType(_type), _value, _sourceLocation.compat_to_string());
+        if(_type == eofTokenType) { return FORMAT("(typ: {}, sl:{})", comp_tokType(_type), getSourceLocation().compat_to_string()); }
+        return FORMAT("(typ: {}, val: '{}', sl:{})", comp_tokType(_type), getValue(), getSourceLocation().compat_to_string());
     }
 }  // namespace vnd
 // NOLINTEND(*-include-cleaner)
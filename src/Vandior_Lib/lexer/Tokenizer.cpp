@@ -4,100 +4,318 @@ using namespace std::literals::string_view_literals;
 // NOLINTBEGIN(*-include-cleaner, *-easily-swappable-parameters, *-avoid-magic-numbers, *-magic-numbers)
 DISABLE_WARNINGS_PUSH(26446)
 namespace vnd {
+    // Average source bytes per token and per statement, used to size the token stream up front.
+    static inline constexpr std::size_t bytesPerToken = 4;
+    static inline constexpr std::size_t bytesPerStatement = 32;
+
+    void Tokenizer::reset(const std::string_view &input, const std::string_view &fileName) {
+        if(input.data() != _input.data() || input.size() != _inputSize || fileName != _filename) {
+            if(_source) {
+                SourceManager::rebind(_source.get(), fileName, input);
+            } else {
+                _source = SourceHandle{fileName, input};
+                _fileId = _source.get();
+            }
+        }
+        _input = input;
+        _filename = fileName;
+        _inputSize = input.size();
+        rewind();
+    }
+
+    void Tokenizer::rewind() noexcept {
+        tokens.clear();
+        position = 0;
+        brackets.clear();
+        bracketNum = 0;
+        _readIndex = 0;
+        _statementIndex = 0;
+        _finished = false;
+        _eofToken = Token{};
+        _lineBreaks.clear();
+    }
+
+    TokenStream Tokenizer::tokenize() {
+        lexAll();
+        return std::move(tokens);
+    }
+
+    const TokenStream &Tokenizer::lex() {
+        lexAll();
+        return tokens;
+    }
+
+    void Tokenizer::lexAll() {
+        rewind();
+        tokens.reserve(_inputSize / bytesPerToken + 1, _inputSize / bytesPerStatement + 1);
+        while(positionIsInText()) { lexStep(); }
+        finish();
+    }
 
-    std::vector<TokenVec> Tokenizer::tokenize() {
-        tokens.reserve(_inputSize);
+    namespace {
+        // Change of the open curly brackets after a token; they are the only brackets open at a statement start.
+        std::size_t curlyDepth(std::size_t depth, const Token &token) noexcept {
+            if(token.isType(TokenType::OPEN_CUR_PARENTESIS)) { return depth + 1; }
+            if(token.isType(TokenType::CLOSE_CUR_PARENTESIS)) { return depth - 1; }
+            return depth;
+        }
+    }  // namespace
+
+    RelexResult Tokenizer::tokenize(const TokenStream &previous, const SourceEdit &edit) {
+        return relex(previous, edit, SourceManager::get(previous.tokens().front().getFileId()).text);
+    }
+
+    RelexResult Tokenizer::tokenize(const TokenStream &previous, const std::string_view &input, const SourceEdit &edit) {
+        const auto oldText = _input;
+        SourceManager::rebind(_fileId, input, edit);
+        _input = input;
+        _inputSize = input.size();
+        return relex(previous, edit, oldText);
+    }
+
+    RelexResult Tokenizer::relex(const TokenStream &previous, const SourceEdit &edit, const std::string_view oldText) {
+        rewind();
+        const auto oldTokens = previous.tokens();
+        const auto &oldStatements = previous.statements();
+        const auto oldFileId = oldTokens.front().getFileId();
+        const auto delta = edit.shift();
+
+        // A token ending right at the edit may grow, so the first touched token is the first one ending at or after it.
+        const auto touched = C_ST(std::ranges::partition_point(oldTokens, [&edit](const Token &token) {
+                                      return C_ST(token.getOffset()) + token.getValueSize() < edit.begin;
+                                  }) - oldTokens.begin());
+        // Restart at the last non-empty statement whose first token comes before it, or at the very beginning.
+        auto restart = C_ST(
+            std::ranges::partition_point(oldStatements, [touched](const StatementRange &range) { return range.begin < touched; }) -
+            oldStatements.begin());
+        while(restart > 0 && oldStatements[restart - 1].size() == 0) { --restart; }
+        restart = restart > 0 ? restart - 1 : 0;
+        const auto restartToken = restart > 0 ? oldStatements[restart].begin : 0;
+
+        tokens.reserve(oldTokens.size() + edit.replacement.size() / bytesPerToken + 1, oldStatements.size() + 1);
+        tokens.append(previous, 0, restart, {oldFileId, _fileId, oldText, _input, 0});
+        position = restart > 0 ? oldTokens[restartToken].getOffset() : 0;
+        std::size_t depth = 0;
+        for(const auto &token : oldTokens.first(restartToken)) { depth = curlyDepth(depth, token); }
+        brackets.assign(depth, TokenType::OPEN_CUR_PARENTESIS);
+
+        const auto editEnd = edit.begin + edit.replacement.size();
+        auto oldIndex = restartToken;
         while(positionIsInText()) {
-            const char &currentChar = _input.at(position);
-            if(C_BOOL(std::isalpha(currentChar))) [[likely]] {
-                tokens.emplace_back(handleAlpha());
-            } else if(C_BOOL(std::isdigit(currentChar))) [[likely]] {
-                tokens.emplace_back(handleDigits());
-            } else if(TokenizerUtility::isUnderscore(currentChar)) [[likely]] {
-                tokens.emplace_back(handleUnderscoreAlpha());
-            } else if(TokenizerUtility::isHasterisc(currentChar)) [[likely]] {
-                tokens.emplace_back(handleHexadecimalOrOctal());
-            } else if(C_BOOL(std::isspace(currentChar))) [[likely]] {
-                handleWhiteSpace();
-            } else if(TokenizerUtility::isComment(_input, position)) {
+            const auto closed = tokens.size();
+            lexStep();
+            // Only a statement start past the edit can match the previous stream again.
+            if(position < editEnd || tokens.size() == closed || tokens.statements().back().end != tokens.tokenCount()) { continue; }
+            const auto oldOffset = C_ST(C_I64T(position) - delta);
+            for(; oldIndex < oldTokens.size() && oldTokens[oldIndex].getOffset() < oldOffset; ++oldIndex) {
+                depth = curlyDepth(depth, oldTokens[oldIndex]);
+            }
+            if(oldIndex == oldTokens.size() || oldTokens[oldIndex].getOffset() != oldOffset || depth != brackets.size()) { continue; }
+            auto statement = C_ST(std::ranges::partition_point(
+                                      oldStatements, [oldIndex](const StatementRange &range) { return range.begin < oldIndex; }) -
+                                  oldStatements.begin());
+            while(statement < oldStatements.size() && oldStatements[statement].size() == 0) { ++statement; }
+            if(statement == oldStatements.size() || oldStatements[statement].begin != oldIndex) { continue; }
+            const auto relexEnd = tokens.size();
+            tokens.append(previous, statement, oldStatements.size(), {oldFileId, _fileId, oldText, _input, delta});
+            return {std::move(tokens), restart, relexEnd, statement};
+        }
+        finish();
+        const auto relexEnd = tokens.size();
+        return {std::move(tokens), restart, relexEnd, oldStatements.size()};
+    }
+
+    TokenStream Tokenizer::tokenizeParallel(std::size_t threadCount, const std::size_t minChunkSize) {
+        if(threadCount == 0) { threadCount = std::max(1U, std::thread::hardware_concurrency()); }
+        rewind();
+        // Chunks start at the first non-whitespace byte of a line, so no whitespace run or line break is split.
+        std::vector<std::size_t> starts{position};
+        for(std::size_t chunk = 1; chunk < threadCount; ++chunk) {
+            const auto target = std::max(starts.back() + minChunkSize, _inputSize / threadCount * chunk);
+            if(target >= _inputSize) { break; }
+            const auto newline = SimdScanner::findNewline(_input, target);
+            if(newline >= _inputSize) { break; }
+            const auto start = SimdScanner::skipWhitespace(_input, newline + 1).position;
+            if(start >= _inputSize) { break; }
+            starts.push_back(start);
+        }
+        if(starts.size() == 1) { return tokenize(); }
+        starts.push_back(_inputSize);
+
+        std::vector<std::future<Chunk>> workers;
+        workers.reserve(starts.size() - 1);
+        for(std::size_t chunk = 0; chunk + 1 < starts.size(); ++chunk) {
+            workers.emplace_back(std::async(std::launch::async, &Tokenizer::lexChunk, this, starts[chunk], starts[chunk + 1]));
+        }
+        tokens.reserve(_inputSize / bytesPerToken + 1, _inputSize / bytesPerStatement + 1);
+        for(std::size_t chunk = 0; chunk < workers.size(); ++chunk) {
+            auto result = workers[chunk].get();
+            // The previous chunk ended inside this one (a multi-line string or comment), so its start was not a token start.
+            if(position != starts[chunk]) [[unlikely]] { result = lexChunk(position, starts[chunk + 1]); }
+            stitch(result);
+        }
+        finish();
+        return std::move(tokens);
+    }
+
+    Tokenizer::Chunk Tokenizer::lexChunk(const std::size_t begin, const std::size_t end) const {
+        Tokenizer worker{_input, _filename, _fileId, begin};
+        worker.tokens.reserve((end - std::min(begin, end)) / bytesPerToken + 1, 0);
+        Chunk chunk;
+        try {
+            while(worker.position < end) { worker.lexStep(); }
+        } catch(...) { chunk.error = std::current_exception(); }
+        chunk.tokens = std::move(worker.tokens);
+        chunk.lineBreaks = std::move(worker._lineBreaks);
+        chunk.end = worker.position;
+        return chunk;
+    }
+
+    void Tokenizer::stitch(const Chunk &chunk) {
+        const auto chunkTokens = chunk.tokens.tokens();
+        auto lineBreak = chunk.lineBreaks.begin();
+        for(std::size_t index = 0; index < chunkTokens.size(); ++index) {
+            for(; lineBreak != chunk.lineBreaks.end() && *lineBreak == index; ++lineBreak) { incrementLine(); }
+            const auto &token = chunkTokens[index];
+            position = C_ST(token.getOffset()) + token.getValueSize();
+            trackBracket(token.getType());
+            tokens.emplace_back(token);
+        }
+        for(; lineBreak != chunk.lineBreaks.end(); ++lineBreak) { incrementLine(); }
+        position = chunk.end;
+        if(chunk.error) [[unlikely]] { std::rethrow_exception(chunk.error); }
+    }
+
+    Token Tokenizer::next() {
+        const Token token = peek();
+        if(_readIndex < tokens.tokenCount()) {
+            ++_readIndex;
+            // Statements fully read through next() are not handed out again by nextStatement().
+            const auto &statements = tokens.statements();
+            while(_statementIndex < statements.size() && statements[_statementIndex].end <= _readIndex) { ++_statementIndex; }
+        }
+        return token;
+    }
+
+    const Token &Tokenizer::peek() {
+        while(_readIndex == tokens.tokenCount()) {
+            if(!pull()) { return _eofToken; }
+        }
+        return tokens.tokens()[_readIndex];
+    }
+
+    std::optional<std::span<Token>> Tokenizer::nextStatement() {
+        while(_statementIndex == tokens.size()) {
+            if(!pull()) { return std::nullopt; }
+        }
+        const auto range = tokens.statements()[_statementIndex];
+        auto statement = tokens.mutableStatement(_statementIndex++);
+        // Drop the tokens of the statement already read through next().
+        statement = statement.subspan(std::min(std::max(_readIndex, range.begin) - range.begin, range.size()));
+        _readIndex = std::max(_readIndex, range.end);
+        return statement;
+    }
+
+    bool Tokenizer::pull() {
+        if(_readIndex == tokens.tokenCount() && _statementIndex == tokens.size()) {
+            // Everything lexed so far was handed out: start over, so the window only holds what is still ahead.
+            tokens.clear();
+            _readIndex = 0;
+            _statementIndex = 0;
+        }
+        if(positionIsInText()) {
+            lexStep();
+            return true;
+        }
+        if(_finished) { return false; }
+        finish();
+        return true;
+    }
+
+    void Tokenizer::lexStep() {
+        const char currentChar = _input[position];
+        switch(TokenizerUtility::getCharClass(currentChar)) {
+            using enum CharClass;
+        case Alpha:
+            tokens.emplace_back(handleAlpha());
+            break;
+        case Digit:
+            tokens.emplace_back(handleDigits());
+            break;
+        case Underscore:
+            tokens.emplace_back(handleUnderscoreAlpha());
+            break;
+        case Hash:
+            tokens.emplace_back(handleHexadecimalOrOctal());
+            break;
+        case Space:
+            handleWhiteSpace();
+            break;
+        case Slash:
+            if(TokenizerUtility::isComment(_input, position)) {
                 tokens.emplace_back(handleComment());
-            } else if(TokenizerUtility::isOperator(currentChar)) [[likely]] {
-                auto opTokens = handleOperators();
-                tokens.insert(tokens.end(), std::begin(opTokens), std::end(opTokens));
-            } else if(TokenizerUtility::isDot(currentChar)) {
-                tokens.emplace_back(handleDot());
-            } else if(TokenizerUtility::isBrackets(currentChar)) [[likely]] {
-                tokens.emplace_back(handleBrackets());
-            } else if(TokenizerUtility::isApostrophe(currentChar)) [[likely]] {
-                tokens.emplace_back(handleChar());
-            } else if(TokenizerUtility::isQuotation(currentChar)) [[likely]] {
-                tokens.emplace_back(handleString());
-            } else if(TokenizerUtility::isCommaColon(currentChar)) {
-                incPosAndColumn();
-                tokens.emplace_back(TokenizerUtility::CommaOrColonType(currentChar), TokenizerUtility::CommaOrColonValue(currentChar),
-                                    CodeSourceLocation{_filename, line, column - 1});
-            } else [[unlikely]] {
-                error(std::string(1, currentChar), "Unknown Character");
+                break;
             }
+            [[fallthrough]];
+        case Operator:
+            handleOperators();
+            break;
+        case Dot:
+            tokens.emplace_back(handleDot());
+            break;
+        case Bracket:
+            tokens.emplace_back(handleBrackets());
+            break;
+        case Apostrophe:
+            tokens.emplace_back(handleChar());
+            break;
+        case Quotation:
+            tokens.emplace_back(handleString());
+            break;
+        case CommaColon:
+            incPos();
+            tokens.emplace_back(makeToken(TokenizerUtility::CommaOrColonType(currentChar), _input.substr(position - 1, 1)));
+            break;
+        [[unlikely]] case Unknown:
+        [[unlikely]] default:
+            error(std::string(1, currentChar), "Unknown Character");
         }
-        tokens.emplace_back(TokenType::EOFT, CodeSourceLocation{_filename, line, column});
+    }
+
+    void Tokenizer::finish() {
+        _finished = true;
+        _eofToken = makeToken(TokenType::EOFT, _input.substr(_inputSize));
+        tokens.emplace_back(_eofToken);
         if(!brackets.empty()) { throw std::runtime_error("Mismatch bracket"); }
-        result.emplace_back(tokens);
-        return result;
+        tokens.closeStatement();
     }
 
     bool Tokenizer::positionIsInText() const noexcept { return position < _inputSize; }
 
-    unsigned char Tokenizer::getUnsignedCharAt(const size_t pos) const {
-        if(pos >= _inputSize) { throw std::out_of_range(FORMAT("Position {} out of range 0-{}", pos, _inputSize)); }
-        return C_UC(_input[pos]);
+    Token Tokenizer::makeToken(const TokenType type, const std::string_view value) const noexcept {
+        return {type, _fileId, C_UI32T(value.data() - _input.data()), C_UI32T(value.size())};
     }
 
     Token Tokenizer::handleAlpha() {
         const auto start = position;
         auto type = TokenType::IDENTIFIER;
-        // clang-format off
-        while(positionIsInText() && (TokenizerUtility::isalnumUnderscore(_input[position]))) {
-            incPosAndColumn();
-        }
-        // clang-format on
+        advanceTo(SimdScanner::skipIdentifier(_input, position));
         const auto value = _input.substr(start, position - start);
         kewordType(value, type);
-        return {type, value, {_filename, line, column - value.size()}};
+        return makeToken(type, value);
     }
 
     Token Tokenizer::handleUnderscoreAlpha() {
         const auto start = position;
-        incPosAndColumn();
-        while(positionIsInText() && (TokenizerUtility::isalnumUnderscore(_input[position]))) { incPosAndColumn(); }
+        incPos();
+        advanceTo(SimdScanner::skipIdentifier(_input, position));
         const auto value = _input.substr(start, position - start);
-        return {TokenType::IDENTIFIER, value, {_filename, line, column - value.size()}};
+        return makeToken(TokenType::IDENTIFIER, value);
     }
 
-    DISABLE_WARNINGS_PUSH(26446 26447)
-    // NOLINTBEGIN(*-identifier-length, *-qualified-auto)
-    void Tokenizer::getType(const std::string_view &value, TokenType &type) noexcept {
-        const auto it = std::ranges::find_if(typeArray, [&value](const auto &pair) { return pair.first == value; });
+    void Tokenizer::kewordType(const std::string_view &value, TokenType &type) noexcept { type = keywordTypeTable.find(value, type); }
 
-        if(it != typeArray.end()) {
-            type = it->second;  // Assign the found type
-        }
-    }
-
-    void Tokenizer::kewordType(const std::string_view &value, TokenType &type) noexcept {
-        // Use std::find_if to search for the keyword type
-        const auto it = std::ranges::find_if(keywordArray, [&value](const auto &pair) { return pair.first == value; });
-
-        if(it != keywordArray.end()) {
-            type = it->second;  // Assign the found type
-        } else [[unlikely]] {
-            getType(value, type);  // Call getType for other types
-        }
-    }
-    // NOLINTEND(*-identifier-length, *-qualified-auto)
-    DISABLE_WARNINGS_POP()
-
-    bool Tokenizer::inTextAndE() const noexcept { return positionIsInText() && std::toupper(_input[position]) == ECR; }
+    bool Tokenizer::inTextAndE() const noexcept { return positionIsInText() && (_input[position] == ECR || _input[position] == 'e'); }
     bool Tokenizer::inTextAnd(char chr) const noexcept { return positionIsInText() && _input[position] == chr; }
 
     Token Tokenizer::handleDigits() {
@@ -106,133 +324,117 @@ namespace vnd {
         const auto start = position;
         extractDigits();
         if(inTextAnd(PNT)) {
-            incPosAndColumn();
+            incPos();
             extractDigits();
             if(inTextAndE()) {
-                incPosAndColumn();
+                incPos();
                 extractExponent();
             }
             tokenType = DOUBLE;
         }
         if(inTextAndE()) {
-            incPosAndColumn();
+            incPos();
             extractExponent();
             tokenType = DOUBLE;
         }
         if(inTextAnd(icr)) {
-            incPosAndColumn();
+            incPos();
             tokenType = DOUBLE;
         }
         if(inTextAnd(fcr)) {
-            incPosAndColumn();
+            incPos();
             tokenType = DOUBLE;
         }
         const auto value = _input.substr(start, position - start);
-        return {tokenType, value, {_filename, line, column - value.size()}};
+        return makeToken(tokenType, value);
     }
 
     Token Tokenizer::handleComment() {
         const auto nextposition = position + 1;
         if(_input[nextposition] == slashcr) { return handleSingleLineComment(); }
         if(_input[nextposition] == starcr) { return handleMultiLineComment(); }
-        return {TokenType::UNKNOWN, {_filename, line, column}};
+        return makeToken(TokenType::UNKNOWN, _input.substr(position, 0));
     }
 
     Token Tokenizer::handleSingleLineComment() {
         const auto start = position;
-        while(positionIsInText() && _input[position] != NL) { incPosAndColumn(); }
+        advanceTo(SimdScanner::findNewline(_input, position));
         const auto value = _input.substr(start, position - start);
-        return {TokenType::COMMENT, value, {_filename, line, column - value.size()}};
+        return makeToken(TokenType::COMMENT, value);
     }
 
     Token Tokenizer::handleMultiLineComment() {
         const auto start = position;
-        const auto startColumn = column;
-        while(_input[position] != starcr || _input[position + 1] != slashcr) {
-            if(!positionIsInText()) {
-                const auto value = _input.substr(start, position - start);
-                return {TokenType::UNKNOWN, value, {_filename, line, startColumn}};
-            }
-            // Advance to the next character
-            incPosAndColumn();
-            handleWhiteSpaceSingle();
+        incPos();  // Skip '/'
+        incPos();  // Skip '*'
+        advanceTo(SimdScanner::skipBlockComment(_input, position));
+        if(!positionIsInText()) [[unlikely]] {
+            const auto value = _input.substr(start, position - start);
+            return makeToken(TokenType::UNKNOWN, value);
         }
-        incPosAndColumn();  // Skip '*'
-        incPosAndColumn();  // Skip '/'
+        incPos();  // Skip '*'
+        incPos();  // Skip '/'
         const auto value = _input.substr(start, position - start);
-        return {TokenType::COMMENT, value, {_filename, line, startColumn}};
+        return makeToken(TokenType::COMMENT, value);
     }
 
     Token Tokenizer::handleDot() {
         const auto start = position;
         auto type = TokenType::DOT;
-        incPosAndColumn();
-        if(positionIsInText() && C_BOOL(std::isdigit(getUnsignedCharAt(position)))) {
+        incPos();
+        if(positionIsInText() && TokenizerUtility::hasTrait(_input[position], TRAIT_DIGIT)) {
             type = TokenType::DOUBLE;
             extractDigits();
             if(inTextAndE()) {
-                incPosAndColumn();
+                incPos();
                 extractExponent();
             }
-            if(inTextAnd(icr)) { incPosAndColumn(); }
-            if(inTextAnd(fcr)) { incPosAndColumn(); }
+            if(inTextAnd(icr)) { incPos(); }
+            if(inTextAnd(fcr)) { incPos(); }
         }
         const auto value = _input.substr(start, position - start);
-        return {type, value, {_filename, line, column - value.size()}};
+        return makeToken(type, value);
     }
 
     void Tokenizer::extractExponent() noexcept {
-        if(positionIsInText() && TokenizerUtility::isPlusOrMinus(_input[position])) { incPosAndColumn(); }
+        if(positionIsInText() && TokenizerUtility::isPlusOrMinus(_input[position])) { incPos(); }
         extractDigits();
     }
 
     void Tokenizer::extractDigits() noexcept {
-        while(positionIsInText() && C_BOOL(std::isdigit(_input[position]))) { incPosAndColumn(); }
+        while(positionIsInText() && TokenizerUtility::hasTrait(_input[position], TRAIT_DIGIT)) { incPos(); }
     }
 
-    void Tokenizer::incPosAndColumn() noexcept {
-        position++;
-        column++;
-    }
+    void Tokenizer::incPos() noexcept { position++; }
 
     void Tokenizer::incrementLine() noexcept {
-        if(bracketNum == 0) {
-            result.push_back(tokens);
-            tokens = {};
-        }
-        ++line;
-        column = 0;
-    }
-
-    void Tokenizer::handleWhiteSpaceSingle() noexcept {
-        // Check if we're at the start of a line with '\n' or '\r\n'
-        char const charnsl = _input[position];
-        if(charnsl == NL) [[unlikely]] {
-            incrementLine();
-        } else if(charnsl == '\r') [[unlikely]] {
-            // Handle '\r' (carriage return), which might be followed by '\n'
-            if(const std::size_t nextPosition = position + 1; nextPosition < _inputSize && _input[nextPosition] == NL) {
-                incrementLine();
-                position++;  // Skip the '\n' that follows '\r'
-            } else [[unlikely]] {
-                incrementLine();
-            }
+        if(_chunkMode) [[unlikely]] {
+            _lineBreaks.push_back(tokens.tokenCount());
+            return;
         }
-
-        // Increment position and column to move to the next character
-        incPosAndColumn();
+        if(bracketNum == 0) { tokens.closeStatement(); }
     }
 
-    void Tokenizer::handleWhiteSpace() noexcept {
-        while(positionIsInText() && C_BOOL(std::isspace(_input[position]))) { handleWhiteSpaceSingle(); }
+    void Tokenizer::handleWhiteSpace() noexcept { advanceTo(SimdScanner::skipWhitespace(_input, position)); }
+
+    void Tokenizer::advanceTo(const std::size_t newPosition) noexcept { position = newPosition; }
+
+    void Tokenizer::advanceTo(const ScanResult &scan) noexcept {
+        for(std::size_t i = 0; i < scan.newlines; ++i) { incrementLine(); }
+        position = scan.position;
     }
 
     Token Tokenizer::handleBrackets() {
-        using enum TokenType;
         const auto start = position;
-        incPosAndColumn();
+        incPos();
         const auto value = _input.substr(start, position - start);
         const auto type = getBracketsType(value);
+        if(!_chunkMode) { trackBracket(type); }
+        return makeToken(type, value);
+    }
+
+    void Tokenizer::trackBracket(const TokenType type) {
+        using enum TokenType;
         switch(type) {
         case OPEN_PARENTESIS:
         case OPEN_SQ_PARENTESIS:
@@ -253,7 +455,6 @@ namespace vnd {
         default:
             break;
         }
-        return {type, value, {_filename, line, column - value.size()}};
     }
 
     void Tokenizer::removeBrackets(const TokenType &type) {
@@ -263,56 +464,34 @@ namespace vnd {
     }
 
     Token Tokenizer::handleChar() {
-        incPosAndColumn();
+        incPos();
         const auto start = position;
-        std::string_view value{};
-        while(!TokenizerUtility::isApostrophe(_input[position])) {
-            if(position + 1 == _inputSize) {
-                incPosAndColumn();
-                value = _input.substr(start, position - start);
-                return {TokenType::UNKNOWN, value, {_filename, line, column - value.size()}};
-            }
-            incPosAndColumn();
-        }
-        value = _input.substr(start, position - start);
-        const auto colum = column - value.size();
-        incPosAndColumn();
-        return {TokenType::CHAR, value, {_filename, line, colum}};
+        while(positionIsInText() && !TokenizerUtility::isApostrophe(_input[position])) { incPos(); }
+        const auto value = _input.substr(start, position - start);
+        if(!positionIsInText()) [[unlikely]] { return makeToken(TokenType::UNKNOWN, value); }
+        incPos();
+        return makeToken(TokenType::CHAR, value);
     }
 
     Token Tokenizer::handleString() {
-        const auto startColumn = column;
-        incPosAndColumn();
+        incPos();
         const auto start = position;
-        std::string_view value{};
-        while(!TokenizerUtility::isQuotation(_input[position])) {
-            if(position + 1 == _inputSize) {
-                incPosAndColumn();
-                value = _input.substr(start, position - start);
-                return {TokenType::UNKNOWN, value, {_filename, line, startColumn}};
-            }
-            handleWhiteSpaceSingle();
-        }
-        value = _input.substr(start, position - start);
-        incPosAndColumn();
-        return {TokenType::STRING, value, {_filename, line, startColumn}};
+        advanceTo(SimdScanner::skipString(_input, position));
+        const auto value = _input.substr(start, position - start);
+        if(!positionIsInText()) [[unlikely]] { return makeToken(TokenType::UNKNOWN, value); }
+        incPos();
+        return makeToken(TokenType::STRING, value);
     }
 
     void Tokenizer::extractVarLenOperator() {
-        while(positionIsInText() && TokenizerUtility::isOperator(_input[position])) { incPosAndColumn(); }
+        while(positionIsInText() && TokenizerUtility::isOperator(_input[position])) { incPos(); }
     }
 
     TokenType Tokenizer::multyCharOp(const std::string_view &view) noexcept {
-        // NOLINTNEXTLINE(*-identifier-length, *-qualified-auto)
-        if(const auto it = std::ranges::find_if(multiCharOperators, [&](const auto &pair) { return pair.first == view; });
-           it != multiCharOperators.end()) {
-            return it->second;
-        }
-        return TokenType::UNKNOWN;
+        return multiCharOperatorTable.find(view, TokenType::UNKNOWN);
     }
 
-    std::vector<Token> Tokenizer::handleOperators() {
-        std::vector<Token> code;
+    void Tokenizer::handleOperators() {
         const auto start = position;
         extractVarLenOperator();
         auto value = _input.substr(start, position - start);
@@ -320,42 +499,39 @@ namespace vnd {
             Token token;
             if(value.size() > 1) {
                 const auto twoCharOp = value.substr(0, 2);
-                token = {multyCharOp(twoCharOp), twoCharOp, {_filename, line, column - twoCharOp.size()}};
+                token = makeToken(multyCharOp(twoCharOp), twoCharOp);
             }
             if(token.isType(TokenType::UNKNOWN) || value.size() == 1) {
                 const auto oneCharOp = value.substr(0, 1);
-                token = Token{singoleCharOp(oneCharOp[0]), oneCharOp, {_filename, line, column - oneCharOp.size()}};
+                token = makeToken(singoleCharOp(oneCharOp[0]), oneCharOp);
             }
 
-            code.emplace_back(token);
+            tokens.emplace_back(token);
             value.remove_prefix(token.getValueSize());
         }
-
-        return code;
     }
 
     template <StringOrStringView T> void Tokenizer::error(const T &value, const std::string_view &errorMsg) {
-        ErrorHandler errorHandler(_input, _filename, line, column);
-        errorHandler.setCurrentPosition(position);
+        ErrorHandler errorHandler(_fileId, position);
         errorHandler.handleError(value, errorMsg);
     }
     Token Tokenizer::handleHexadecimalOrOctal() {
         const auto start = position;
-        incPosAndColumn();
-        if(positionIsInText() && std::tolower(getUnsignedCharAt(position)) == 'o') {
+        incPos();
+        if(inTextAnd('o') || inTextAnd('O')) {
             // Gestione dei numeri ottali
-            incPosAndColumn();
-            while(positionIsInText() && TokenizerUtility::isOctalDigit(_input[position])) { incPosAndColumn(); }
-        } else if(positionIsInText() && C_BOOL(std::isxdigit(getUnsignedCharAt(position)))) {
+            incPos();
+            while(positionIsInText() && TokenizerUtility::hasTrait(_input[position], TRAIT_OCTAL)) { incPos(); }
+        } else if(positionIsInText() && TokenizerUtility::hasTrait(_input[position], TRAIT_HEX)) {
             // Gestione dei numeri esadecimali
-            while(positionIsInText() && C_BOOL(std::isxdigit(getUnsignedCharAt(position)))) { incPosAndColumn(); }
+            while(positionIsInText() && TokenizerUtility::hasTrait(_input[position], TRAIT_HEX)) { incPos(); }
         } else [[unlikely]] {
             const auto error_value = _input.substr(start, position);
             error(error_value, "malformed exadecimal number or octal number");
         }
 
         const auto value = _input.substr(start, position - start);
-        return {TokenType::INTEGER, value, {_filename, line, column - value.size() - 1}};
+        return makeToken(TokenType::INTEGER, value);
     }
 }  // namespace vnd
 DISABLE_WARNINGS_POP()
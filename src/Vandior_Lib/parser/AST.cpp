@@ -1,7 +1,7 @@
 /*
  * Created by gbian on 20/10/2024.
  */
-// NOLINTBEGIN(*-include-cleaner, *-qualified-auto, *-no-recursion, *-easily-swappable-parameters)
+// NOLINTBEGIN(*-include-cleaner, *-qualified-auto, *-easily-swappable-parameters)
 #include "Vandior/parser/AST.hpp"
 
 /** \cond */
@@ -25,78 +25,90 @@ void printParentNode(const vnd::ASTNode &node, const std::string &indentmark) {
 }
 
 // Helper functions for printing different node types
-void printBinaryNode(const vnd::BinaryExpressionNode &node, const std::string &imarknode, const std::string &newindent) {
+void printBinaryNode(const vnd::BinaryExpressionNode &node, const std::string &imarknode, std::vector<PrettyPrintItem> &children) {
     LINFO(PRETTYPRINT_AST_FORMAT, imarknode, node.getOp());
-    prettyPrint(*node.getLeft(), newindent, false, "L");
-    prettyPrint(*node.getRight(), newindent, true, "R");
+    children.emplace_back(node.getLeft().get(), false, "L");
+    children.emplace_back(node.getRight().get(), true, "R");
 }
 
-void printUnaryNode(const vnd::UnaryExpressionNode &node, const std::string &imarknode, const std::string &newindent) {
+void printUnaryNode(const vnd::UnaryExpressionNode &node, const std::string &imarknode, std::vector<PrettyPrintItem> &children) {
     LINFO(PRETTYPRINT_AST_FORMAT, imarknode, node.getOp());
-    prettyPrint(*node.getOperand(), newindent, true, "OPR");
+    children.emplace_back(node.getOperand().get(), true, "OPR");
 }
 
-void printVariableNode(const vnd::VariableNode &node, const std::string &imarknode, const std::string &newindent) {
+void printVariableNode(const vnd::VariableNode &node, const std::string &imarknode, std::vector<PrettyPrintItem> &children) {
     LINFO(PRETTYPRINT_AST_FORMAT2, imarknode, node.getName());
 
     if(node.is_call()) {
-        if(const auto &callNode = node.get_call()) { prettyPrint(*callNode, newindent, true, "CALL"); }
+        if(const auto &callNode = node.get_call()) { children.emplace_back(callNode.get(), true, "CALL"); }
     }
-    if(const auto &indexNode = node.get_index()) { prettyPrint(*indexNode, newindent, true, "INDEX"); }
+    if(const auto &indexNode = node.get_index()) { children.emplace_back(indexNode.get(), true, "INDEX"); }
 }
-void printIndexNode(const vnd::IndexNode &node, const std::string &indentmark, const std::string &newindent) {
+void printIndexNode(const vnd::IndexNode &node, const std::string &indentmark, std::vector<PrettyPrintItem> &children) {
     LINFO("{}", indentmark, node.comp_print());
-    if(const auto &elementsNode = node.get_elements()) { prettyPrint(*elementsNode, newindent, true, ""); }
-    if(const auto &elementsIndexNode = node.get_index()) { prettyPrint(*elementsIndexNode, newindent, true, "INDEX"); }
-    if(const auto &elementsArrayNode = node.get_array()) { prettyPrint(*elementsArrayNode, newindent, true, "ELEM"); }
+    if(const auto &elementsNode = node.get_elements()) { children.emplace_back(elementsNode.get(), true, ""); }
+    if(const auto &elementsIndexNode = node.get_index()) { children.emplace_back(elementsIndexNode.get(), true, "INDEX"); }
+    if(const auto &elementsArrayNode = node.get_array()) { children.emplace_back(elementsArrayNode.get(), true, "ELEM"); }
 }
 
-void printArrayNode(const vnd::ArrayNode &node, const std::string &indentmark, const std::string &newindent) {
+void printArrayNode(const vnd::ArrayNode &node, const std::string &indentmark, std::vector<PrettyPrintItem> &children) {
     LINFO("{} {}", indentmark, node.comp_print());
-    if(node.get_elements()) { prettyPrint(*node.get_elements(), newindent, true, ""); }
+    if(node.get_elements()) { children.emplace_back(node.get_elements().get(), true, ""); }
+}
+
+void printDeclarationNode(const vnd::DeclarationNode &node, const std::string &imarknode, std::vector<PrettyPrintItem> &children) {
+    LINFO("{})", imarknode);
+    const auto &typeNode = node.get_declared_type();
+    const auto &initializersNode = node.get_initializers();
+    if(node.get_names()) { children.emplace_back(node.get_names().get(), !typeNode && !initializersNode, "NAMES"); }
+    if(typeNode) { children.emplace_back(typeNode.get(), !initializersNode, "TYPE"); }
+    if(initializersNode) { children.emplace_back(initializersNode.get(), true, "INIT"); }
 }
 
 // Main prettyPrint function refactored
 void prettyPrint(const vnd::ASTNode &node, const std::string &indent, bool isLast, const std::string &lorf) {
-    const auto &indentmark = FORMAT("{}{}{}", indent, isLast ? "+-" : "|-", lorf);
-    const auto &newindent = FORMAT("{}{}", indent, isLast ? "  " : "| ");
-    const auto &imarknode = FORMAT("{}({}", indentmark, comp_NodeType(node.getType()));
+    // Nodes still to print, the next one on top; the children of a node are pushed in reverse.
+    std::vector<PrettyPrintItem> pending{{&node, isLast, lorf, 0}};
+    std::vector<PrettyPrintItem> children;
+    // Whether every ancestor of the node being printed is the last child of its parent, root first.
+    std::vector<bool> lastAncestors;
+    std::string nodeIndent;
+    while(!pending.empty()) {
+        const auto item = pending.back();
+        pending.pop_back();
+        lastAncestors.resize(item.depth);
+        nodeIndent = indent;
+        for(const auto last : lastAncestors) { nodeIndent += last ? "  " : "| "; }
+        const auto &indentmark = FORMAT("{}{}{}", nodeIndent, item.isLast ? "+-" : "|-", item.lorf);
+        const auto &imarknode = FORMAT("{}({}", indentmark, comp_NodeType(item.node->getType()));
 
-    // printParentNode(node, indentmark);
-    // Determine the type of node and print information
-    if(const auto *binaryNode = node.safe_as<vnd::BinaryExpressionNode>()) {
-        printBinaryNode(*binaryNode, imarknode, newindent);
-    } else if(const auto *unaryNode = node.safe_as<vnd::UnaryExpressionNode>()) {
-        printUnaryNode(*unaryNode, imarknode, newindent);
-    } else if(const auto *variableNode = node.safe_as<vnd::VariableNode>()) {
-        printVariableNode(*variableNode, imarknode, newindent);
-    } else if(const auto *intnumberNode = node.safe_as<VND_NUM_INT>()) {
-        LINFO(PRETTYPRINT_AST_FORMAT3, imarknode, NumNodeType_comp(intnumberNode->getNumberType()), intnumberNode->get_value());
-    } else if(const auto *cflnumberNode = node.safe_as<VND_NUM_CFLOAT>()) {
-        LINFO(PRETTYPRINT_AST_FORMAT3, imarknode, NumNodeType_comp(cflnumberNode->getNumberType()), cflnumberNode->get_value());
-    } else if(const auto *dflnumberNode = node.safe_as<VND_NUM_CDOUBLE>()) {
-        LINFO(PRETTYPRINT_AST_FORMAT3, imarknode, NumNodeType_comp(dflnumberNode->getNumberType()), dflnumberNode->get_value());
-    } else if(const auto *flnumberNode = node.safe_as<VND_NUM_FLOAT>()) {
-        LINFO(PRETTYPRINT_AST_FORMAT3, imarknode, NumNodeType_comp(flnumberNode->getNumberType()), flnumberNode->get_value());
-    } else if(const auto *dblnumberNode = node.safe_as<VND_NUM_DOUBLE>()) {
-        LINFO(PRETTYPRINT_AST_FORMAT3, imarknode, NumNodeType_comp(dblnumberNode->getNumberType()), dblnumberNode->get_value());
-    } else if(const auto *blliteralNode = node.safe_as<vnd::LiteralNode<bool>>()) {
-        LINFO(PRETTYPRINT_AST_FORMAT2, imarknode, blliteralNode->get_value());
-    } else if(const auto *chliteralNode = node.safe_as<vnd::LiteralNode<char>>()) {
-        LINFO(PRETTYPRINT_AST_FORMAT2, imarknode, chliteralNode->get_value());
-    } else if(const auto *svliteralNode = node.safe_as<vnd::LiteralNode<std::string_view>>()) {
-        LINFO(PRETTYPRINT_AST_FORMAT2, imarknode, svliteralNode->get_value());
-    } else if([[maybe_unused]] const auto *nullptrNode = node.safe_as<vnd::NullptrNode>()) {
-        LINFO(PRETTYPRINT_AST_NULLPTR, imarknode);
-    } else if(const auto *typeNode = node.safe_as<vnd::TypeNode>()) {
-        LINFO("{}, {})", imarknode, typeNode->get_value());
-        if(typeNode->get_index()) { prettyPrint(*typeNode->get_index(), newindent, true, "INDEX"); }
-    } else if(const auto *indexNode = node.safe_as<vnd::IndexNode>()) {
-        printIndexNode(*indexNode, indentmark, newindent);
-    } else if(const auto *arrayNode = node.safe_as<vnd::ArrayNode>()) {
-        printArrayNode(*arrayNode, indentmark, newindent);
-    } else {
-        LERROR("Unknown or not handled node type: {}", node.getType());
+        // printParentNode(*item.node, indentmark);
+        // Dispatch on the node class and print information
+        children.clear();
+        vnd::visit(*item.node,
+                   vnd::Overloaded{
+                       [&](const vnd::BinaryExpressionNode &binaryNode) { printBinaryNode(binaryNode, imarknode, children); },
+                       [&](const vnd::UnaryExpressionNode &unaryNode) { printUnaryNode(unaryNode, imarknode, children); },
+                       [&](const vnd::VariableNode &variableNode) { printVariableNode(variableNode, imarknode, children); },
+                       [&]<typename T>(const vnd::NumberNode<T> &numberNode) {
+                           LINFO(PRETTYPRINT_AST_FORMAT3, imarknode, NumNodeType_comp(numberNode.getNumberType()), numberNode.get_value());
+                       },
+                       [&]<typename T>(const vnd::LiteralNode<T> &literalNode) { LINFO(PRETTYPRINT_AST_FORMAT2, imarknode, literalNode.get_value()); },
+                       [&](const vnd::NullptrNode & /*nullptrNode*/) { LINFO(PRETTYPRINT_AST_NULLPTR, imarknode); },
+                       [&](const vnd::TypeNode &typeNode) {
+                           LINFO("{}, {})", imarknode, typeNode.get_value());
+                           if(typeNode.get_index()) { children.emplace_back(typeNode.get_index().get(), true, "INDEX"); }
+                       },
+                       [&](const vnd::IndexNode &indexNode) { printIndexNode(indexNode, indentmark, children); },
+                       [&](const vnd::ArrayNode &arrayNode) { printArrayNode(arrayNode, indentmark, children); },
+                       [&](const vnd::DeclarationNode &declarationNode) { printDeclarationNode(declarationNode, imarknode, children); },
+                       [&](const vnd::ASTNode &otherNode) { LERROR("Unknown or not handled node type: {}", otherNode.getType()); },
+                   });
+        lastAncestors.push_back(item.isLast);
+        for(auto &child : children | std::views::reverse) {
+            child.depth = item.depth + 1;
+            pending.emplace_back(child);
+        }
     }
 }
 
@@ -104,4 +116,4 @@ void prettyPrint(const vnd::ASTNode &node, const std::string &indent, bool isLas
 DISABLE_WARNINGS_POP()
 /** \endcond */
 
-// NOLINTEND(*-include-cleaner, *-qualified-auto, *-no-recursion, *-easily-swappable-parameters)
+// NOLINTEND(*-include-cleaner, *-qualified-auto, *-easily-swappable-parameters)
@@ -5,8 +5,8 @@
 #include "Vandior/parser/ArrayNode.hpp"
 
 namespace vnd {
-    ArrayNode::ArrayNode(std::unique_ptr<ASTNode> elements, const Token &token) noexcept
-      : ASTNode(token), m_elements(vnd_move_always_even_const(elements)) {
+    ArrayNode::ArrayNode(NodePtr<ASTNode> elements, const Token &token) noexcept
+      : ASTNode(token, NodeKind::Array), m_elements(vnd_move_always_even_const(elements)) {
         if(m_elements) { m_elements->set_parent(this); }
     }
 
@@ -19,6 +19,11 @@ namespace vnd {
 
     std::string ArrayNode::comp_print() const { return FORMAT("{}", getType()); }
 
-    const std::unique_ptr<ASTNode> &ArrayNode::get_elements() const noexcept { return m_elements; }
+    const NodePtr<ASTNode> &ArrayNode::get_elements() const noexcept { return m_elements; }
+
+    void ArrayNode::rebase(const SourceShift &shift) {
+        ASTNode::rebase(shift);
+        if(m_elements) { m_elements->rebase(shift); }
+    }
 }  // namespace vnd
    // NOLINTEND(*-include-cleaner)
\ No newline at end of file
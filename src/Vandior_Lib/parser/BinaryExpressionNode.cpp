@@ -6,16 +6,16 @@
 #include "Vandior/parser/BinaryExpressionNode.hpp"
 
 namespace vnd {
-    BinaryExpressionNode::BinaryExpressionNode(std::string_view _op, const Token &op_Token, std::unique_ptr<ASTNode> _left,
-                                               std::unique_ptr<ASTNode> _right) noexcept
-      : ASTNode(op_Token), op(_op), left(vnd_move_always_even_const(_left)), right(vnd_move_always_even_const(_right)) {
+    BinaryExpressionNode::BinaryExpressionNode(std::string_view _op, const Token &op_Token, NodePtr<ASTNode> _left,
+                                               NodePtr<ASTNode> _right) noexcept
+      : ASTNode(op_Token, NodeKind::BinaryExpression), op(_op), left(vnd_move_always_even_const(_left)), right(vnd_move_always_even_const(_right)) {
         if(left) { left->set_parent(this); }
         if(right) { right->set_parent(this); }
     }
 
-    BinaryExpressionNode::BinaryExpressionNode(const Token &op_Token, std::unique_ptr<ASTNode> _left,
-                                               std::unique_ptr<ASTNode> _right) noexcept
-      : ASTNode(op_Token), op(op_Token.getValue()), left(vnd_move_always_even_const(_left)), right(vnd_move_always_even_const(_right)) {
+    BinaryExpressionNode::BinaryExpressionNode(const Token &op_Token, NodePtr<ASTNode> _left,
+                                               NodePtr<ASTNode> _right) noexcept
+      : ASTNode(op_Token, NodeKind::BinaryExpression), op(op_Token.getValue()), left(vnd_move_always_even_const(_left)), right(vnd_move_always_even_const(_right)) {
         if(left) { left->set_parent(this); }
         if(right) { right->set_parent(this); }
     }
@@ -32,11 +32,20 @@ namespace vnd {
 
     std::string_view BinaryExpressionNode::getOp() const noexcept { return op; }
 
-    const std::unique_ptr<ASTNode> &BinaryExpressionNode::getLeft() const noexcept { return left; }
+    const NodePtr<ASTNode> &BinaryExpressionNode::getLeft() const noexcept { return left; }
 
-    const std::unique_ptr<ASTNode> &BinaryExpressionNode::getRight() const noexcept { return right; }
+    const NodePtr<ASTNode> &BinaryExpressionNode::getRight() const noexcept { return right; }
     const ASTNode &BinaryExpressionNode::getLeftr() const noexcept { return *left; }
     const ASTNode &BinaryExpressionNode::getRightr() const noexcept { return *right; }
+    NodePtr<ASTNode> BinaryExpressionNode::takeLeft() noexcept { return std::exchange(left, nullptr); }
+    NodePtr<ASTNode> BinaryExpressionNode::takeRight() noexcept { return std::exchange(right, nullptr); }
+
+    void BinaryExpressionNode::rebase(const SourceShift &shift) {
+        ASTNode::rebase(shift);
+        op = shift.apply(op);
+        if(left) { left->rebase(shift); }
+        if(right) { right->rebase(shift); }
+    }
 
 }  // namespace vnd
 
@@ -0,0 +1,26 @@
+// NOLINTBEGIN(*-include-cleaner)
+#include "Vandior/parser/CompilationUnit.hpp"
+
+namespace vnd {
+
+    CompilationUnit::CompilationUnit(std::string source, std::string fileName)
+      : _source(std::move(source)), _fileName(std::move(fileName)), _parser(_source, _fileName, _arena) {}
+
+    const TokenStream &CompilationUnit::tokens() {
+        if(!_tokens) { _tokens.emplace(_parser.getTokenizer().tokenize()); }
+        return *_tokens;
+    }
+
+    const std::vector<Statement> &CompilationUnit::statements() {
+        if(!_statements) { _statements.emplace(_parser.parseTokens(tokens())); }
+        return *_statements;
+    }
+
+    const FlatAST &CompilationUnit::flatAST() {
+        if(!_flatAST) { _flatAST.emplace(FlatAST::fromStatements(statements())); }
+        return *_flatAST;
+    }
+
+}  // namespace vnd
+
+// NOLINTEND(*-include-cleaner)
@@ -0,0 +1,39 @@
+// NOLINTBEGIN(*-include-cleaner)
+#include "Vandior/parser/DeclarationNode.hpp"
+
+namespace vnd {
+    DeclarationNode::DeclarationNode(const Token &token, NodePtr<ASTNode> names, NodePtr<ASTNode> type, NodePtr<ASTNode> initializers) noexcept
+      : ASTNode(token, NodeKind::Declaration), m_names(vnd_move_always_even_const(names)), m_type(vnd_move_always_even_const(type)),
+        m_initializers(vnd_move_always_even_const(initializers)) {
+        if(m_names) { m_names->set_parent(this); }
+        if(m_type) { m_type->set_parent(this); }
+        if(m_initializers) { m_initializers->set_parent(this); }
+    }
+
+    NodeType DeclarationNode::getType() const noexcept { return NodeType::Declaration; }
+
+    std::string DeclarationNode::print() const {
+        const auto printChild = [](const NodePtr<ASTNode> &child) { return child ? child->print() : std::string{}; };
+        return FORMAT("{}(names:{}, type:{}, initializers:{})", getType(), printChild(m_names), printChild(m_type), printChild(m_initializers));
+    }
+
+    std::string DeclarationNode::comp_print() const {
+        const auto printChild = [](const NodePtr<ASTNode> &child) { return child ? child->comp_print() : std::string{}; };
+        return FORMAT("DECL(n:{}, t:{}, i:{})", printChild(m_names), printChild(m_type), printChild(m_initializers));
+    }
+
+    const NodePtr<ASTNode> &DeclarationNode::get_names() const noexcept { return m_names; }
+
+    const NodePtr<ASTNode> &DeclarationNode::get_declared_type() const noexcept { return m_type; }
+
+    const NodePtr<ASTNode> &DeclarationNode::get_initializers() const noexcept { return m_initializers; }
+
+    void DeclarationNode::rebase(const SourceShift &shift) {
+        ASTNode::rebase(shift);
+        if(m_names) { m_names->rebase(shift); }
+        if(m_type) { m_type->rebase(shift); }
+        if(m_initializers) { m_initializers->rebase(shift); }
+    }
+}  // namespace vnd
+
+// NOLINTEND(*-include-cleaner)
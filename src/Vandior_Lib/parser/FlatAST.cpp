@@ -0,0 +1,120 @@
+// NOLINTBEGIN(*-include-cleaner)
+#include "Vandior/parser/FlatAST.hpp"
+
+namespace vnd {
+
+    FlatAST FlatAST::fromStatements(const std::span<const Statement> statements) {
+        FlatAST ast;
+        ast._statementTokens.reserve(statements.size());
+        ast._statementRoots.reserve(statements.size());
+        ast._funData.reserve(statements.size());
+        for(const auto &statement : statements) {
+            ast._statementTokens.emplace_back(C_UI32T(ast._tokens.size()));
+            ast._tokens.emplace_back(statement.get_token());
+            const auto &root = statement.get_root();
+            ast._statementRoots.emplace_back(root ? ast.add(*root, NodeRole::Root) : noNode);
+            ast._funData.emplace_back(statement.get_funData());
+        }
+        return ast;
+    }
+
+    std::string_view FlatAST::text(const NodeId node) const noexcept {
+        switch(_kinds[node]) {
+            using enum NodeKind;
+        case BinaryExpression:
+        case UnaryExpression:
+        case Variable:
+        case String:
+        case Type:
+            return _texts[_payload[node]];
+        default:
+            return {};
+        }
+    }
+
+    NodeId FlatAST::add(const ASTNode &root, const NodeRole role) {
+        const auto first = C_UI32T(_kinds.size());
+        // Nodes still to add, the next one on top; children are pushed in reverse so they come out in pre-order.
+        std::vector<PendingNode> pending{{&root, role, noNode}};
+        // Last child added so far of every node of the tree, indexed from first.
+        std::vector<NodeId> lastChild;
+        while(!pending.empty()) {
+            const auto [node, nodeRole, parent] = pending.back();
+            pending.pop_back();
+            const auto id = addNode(*node, nodeRole, pending);
+            lastChild.emplace_back(noNode);
+            if(parent == noNode) { continue; }
+            auto &last = lastChild[parent - first];
+            (last == noNode ? _firstChild[parent] : _nextSibling[last]) = id;
+            last = id;
+        }
+        return first;
+    }
+
+    NodeId FlatAST::addNode(const ASTNode &node, const NodeRole role, std::vector<PendingNode> &pending) {
+        const auto id = C_UI32T(_kinds.size());
+        _kinds.emplace_back(node.getKind());
+        _tokenIndex.emplace_back(C_UI32T(_tokens.size()));
+        _tokens.emplace_back(node.get_token());
+        _roles.emplace_back(role);
+        _firstChild.emplace_back(noNode);
+        _nextSibling.emplace_back(noNode);
+        _payload.emplace_back(0);
+        _calls.emplace_back(false);
+
+        const auto addText = [this, id](const std::string_view text) {
+            _payload[id] = C_UI32T(_texts.size());
+            _texts.emplace_back(text);
+        };
+        const auto addNumber = [this, id](const NumberValue value) {
+            _payload[id] = C_UI32T(_numbers.size());
+            _numbers.emplace_back(value);
+        };
+        const auto children = pending.size();
+        const auto addChild = [&pending, id](const ASTNode *child, const NodeRole childRole) {
+            if(child != nullptr) { pending.emplace_back(child, childRole, id); }
+        };
+        visit(node, Overloaded{
+                        [&](const BinaryExpressionNode &binaryNode) {
+                            addText(binaryNode.getOp());
+                            addChild(binaryNode.getLeft().get(), NodeRole::Left);
+                            addChild(binaryNode.getRight().get(), NodeRole::Right);
+                        },
+                        [&](const UnaryExpressionNode &unaryNode) {
+                            addText(unaryNode.getOp());
+                            addChild(unaryNode.getOperand().get(), NodeRole::Operand);
+                        },
+                        [&](const VariableNode &variableNode) {
+                            addText(variableNode.getName());
+                            _calls[id] = variableNode.is_call();
+                            addChild(variableNode.get_index().get(), NodeRole::Index);
+                            addChild(variableNode.get_call().get(), NodeRole::Call);
+                        },
+                        [&]<typename T>(const NumberNode<T> &numberNode) { addNumber(numberNode.get_value()); },
+                        [&](const LiteralNode<bool> &boolNode) { _payload[id] = boolNode.get_value() ? 1 : 0; },
+                        [&](const LiteralNode<char> &charNode) { _payload[id] = C_UI32T(C_UC(charNode.get_value())); },
+                        [&](const LiteralNode<std::string_view> &stringNode) { addText(stringNode.get_value()); },
+                        [&](const TypeNode &typeNode) {
+                            addText(typeNode.get_value());
+                            addChild(typeNode.get_index().get(), NodeRole::Index);
+                        },
+                        [&](const IndexNode &indexNode) {
+                            addChild(indexNode.get_elements().get(), NodeRole::Elements);
+                            addChild(indexNode.get_index().get(), NodeRole::Index);
+                            addChild(indexNode.get_array().get(), NodeRole::Array);
+                        },
+                        [&](const ArrayNode &arrayNode) { addChild(arrayNode.get_elements().get(), NodeRole::Elements); },
+                        [&](const DeclarationNode &declarationNode) {
+                            addChild(declarationNode.get_names().get(), NodeRole::Names);
+                            addChild(declarationNode.get_declared_type().get(), NodeRole::DeclaredType);
+                            addChild(declarationNode.get_initializers().get(), NodeRole::Initializers);
+                        },
+                        [](const ASTNode & /*otherNode*/) {},
+                    });
+        std::reverse(pending.begin() + C_PTRDIFT(children), pending.end());
+        return id;
+    }
+
+}  // namespace vnd
+
+// NOLINTEND(*-include-cleaner)
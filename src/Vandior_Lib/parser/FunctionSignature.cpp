@@ -0,0 +1,28 @@
+// NOLINTBEGIN(*-include-cleaner)
+#include "Vandior/parser/FunctionSignature.hpp"
+
+namespace vnd {
+    /// Index of the first parameter token: `fun`, the name and the opening parenthesis come before.
+    static inline constexpr std::size_t firstParameter = 3;
+
+    FunctionSignature FunctionSignature::parse(TokenSpan statement) {
+        using enum TokenType;
+        if(!statement.empty() && statement.back().isType(eofTokenType)) { statement = statement.first(statement.size() - 1); }
+        FunctionSignature signature;
+        if(statement.size() > 1) { signature.name = statement[1].getValue(); }
+        const auto body = !statement.empty() && statement.back().isType(OPEN_CUR_PARENTESIS) ? statement.size() - 1 : statement.size();
+        // The return types run back from the body to the closing parenthesis of the parameter list.
+        auto begin = body;
+        while(begin > firstParameter && !statement[begin - 1].isType(CLOSE_PARENTESIS)) { --begin; }
+        signature.returnTypesBegin = begin;
+        for(auto index = begin; index < body; ++index) {
+            if(!statement[index].isType(COMMA)) { signature.returnTypes.emplace_back(statement[index].getValue()); }
+        }
+        if(begin > firstParameter && statement[begin - 1].isType(CLOSE_PARENTESIS) && statement[firstParameter - 1].isType(OPEN_PARENTESIS)) {
+            signature.parameters = statement.subspan(firstParameter, begin - 1 - firstParameter);
+        }
+        return signature;
+    }
+}  // namespace vnd
+
+// NOLINTEND(*-include-cleaner)
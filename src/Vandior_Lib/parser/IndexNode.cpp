@@ -5,8 +5,8 @@
 #include "Vandior/parser/IndexNode.hpp"
 
 namespace vnd {
-    IndexNode::IndexNode(std::unique_ptr<ASTNode> elements, const Token &token) noexcept
-      : ASTNode(token), m_elements(vnd_move_always_even_const(elements)), m_index(nullptr), m_array(nullptr) {
+    IndexNode::IndexNode(NodePtr<ASTNode> elements, const Token &token) noexcept
+      : ASTNode(token, NodeKind::Index), m_elements(vnd_move_always_even_const(elements)), m_index(nullptr), m_array(nullptr) {
         if(m_elements) { m_elements->set_parent(this); }
     }
 
@@ -19,21 +19,28 @@ namespace vnd {
 
     std::string IndexNode::comp_print() const { return FORMAT("{}", getType()); }
 
-    const std::unique_ptr<ASTNode> &IndexNode::get_elements() const noexcept { return m_elements; }
+    const NodePtr<ASTNode> &IndexNode::get_elements() const noexcept { return m_elements; }
 
-    const std::unique_ptr<IndexNode> &IndexNode::get_index() const noexcept { return m_index; }
+    const NodePtr<IndexNode> &IndexNode::get_index() const noexcept { return m_index; }
 
-    void IndexNode::set_index(std::unique_ptr<IndexNode> index) noexcept {
+    void IndexNode::set_index(NodePtr<IndexNode> index) noexcept {
         m_index = vnd_move_always_even_const(index);
         if(m_index) { m_index->set_parent(this); }
     }
 
-    const std::unique_ptr<ArrayNode> &IndexNode::get_array() const noexcept { return m_array; }
+    const NodePtr<ArrayNode> &IndexNode::get_array() const noexcept { return m_array; }
 
-    void IndexNode::set_array(std::unique_ptr<ArrayNode> _array) noexcept {
+    void IndexNode::set_array(NodePtr<ArrayNode> _array) noexcept {
         m_array = vnd_move_always_even_const(_array);
         if(m_array) { m_array->set_parent(this); }
     }
 
+    void IndexNode::rebase(const SourceShift &shift) {
+        ASTNode::rebase(shift);
+        if(m_elements) { m_elements->rebase(shift); }
+        if(m_index) { m_index->rebase(shift); }
+        if(m_array) { m_array->rebase(shift); }
+    }
+
 }  // namespace vnd
    // NOLINTEND(*-include-cleaner)
\ No newline at end of file
@@ -2,33 +2,194 @@
 #include "Vandior/parser/Parser.hpp"
 #include "Vandior/parser/ParserException.hpp"
 #include "VandiorCore/Log.hpp"
+#include <atomic>
 #include <charconv>
+#include <future>
 #include <system_error>
+#include <thread>
 #include <utility>
 
 DISABLE_WARNINGS_PUSH(26410 26411 26415 26445 26481)
 
 namespace vnd {
     static inline constexpr int bracketPosition = 1;
+
+    /// Number of TokenType values, the size of the tables indexed by TokenType.
+    static inline constexpr std::size_t tokenTypeCount = C_ST(TokenType::EOFT) + 1;
+    using TokenTypeTable = std::array<std::uint8_t, tokenTypeCount>;
+
+    /**
+     * @brief Builds the table of binary operator precedences, 0 for the tokens that are not binary operators.
+     * @param declaration True for the statements of a var keyword, where ',' binds tighter than ':' and '='.
+     * @return The table indexed by TokenType.
+     */
+    static consteval TokenTypeTable makePrecedenceTable(const bool declaration) noexcept {
+        using enum TokenType;
+        TokenTypeTable table{};
+        const auto set = [&table](const TokenType type, const std::uint8_t precedence) { table[C_ST(type)] = precedence; };
+        set(COMMA, declaration ? 2 : 1);
+        set(COLON, declaration ? 1 : 2);
+        set(EQUAL, declaration ? 1 : 3);
+        for(const auto type : {PLUSEQUAL, MINUSEQUAL, STAREQUAL, DIVIDEEQUAL, XOREQUAL, PERCENTEQUAL}) { set(type, 3); }
+        set(OROR, 4);
+        set(ANDAND, 5);
+        for(const auto type : {EQUALEQUAL, NOTEQUAL}) { set(type, 6); }
+        for(const auto type : {LESS, LESSEQUAL, GREATER, GREATEREQUAL}) { set(type, 7); }
+        for(const auto type : {PLUS, MINUS}) { set(type, 8); }
+        for(const auto type : {STAR, DIVIDE}) { set(type, 9); }
+        for(const auto type : {XOR, PERCENT}) { set(type, 10); }
+        set(DOT, 11);
+        return table;
+    }
+
+    static inline constexpr TokenTypeTable operatorPrecedence = makePrecedenceTable(false);   ///< Binary operator precedences.
+    static inline constexpr TokenTypeTable declarationPrecedence = makePrecedenceTable(true);  ///< Precedences in var statements.
+    static inline constexpr std::size_t unaryPrecedence = 12;  ///< Precedence of the unary operators, above every binary one.
+
+    /// Whether each TokenType is a built-in type name.
+    static inline constexpr auto typeTokens = [] {
+        using enum TokenType;
+        TokenTypeTable table{};
+        for(const auto type : {TYPE_I8, TYPE_I16, TYPE_I32, TYPE_I64, TYPE_U8, TYPE_U16, TYPE_U32, TYPE_U64, TYPE_F32, TYPE_F64, TYPE_C32,
+                               TYPE_C64, TYPE_CHAR, TYPE_STRING, TYPE_BOOL}) {
+            table[C_ST(type)] = 1;
+        }
+        return table;
+    }();
+
     std::vector<Statement> Parser::parse() {
-        if(tokens.empty()) { return {}; }
         std::vector<Statement> statements;
         statements.reserve(10);
-        for(auto &innerTokens : tokens) {
-            currentStatement = &innerTokens;
-            if(!currentStatement->empty() && currentStatement->back().getType() == eofTokenType) { currentStatement->pop_back(); }
-            tokenSize = currentStatement->size();
-            position = 0;
-            emplaceStatement(statements);
-            statements.back().set_root(position < tokenSize ? parseExpression() : nullptr);
+        while(const auto statement = tokenizer.nextStatement()) { parseStatement(*statement, statements); }
+        return statements;
+    }
+
+    std::vector<Statement> Parser::parse(TokenStream &tokens) {
+        tokens = tokenizer.tokenize();
+        return parseTokens(tokens);
+    }
+
+    std::vector<Statement> Parser::parseTokens(const TokenStream &tokens) {
+        std::vector<Statement> statements;
+        statements.reserve(tokens.size());
+        for(std::size_t index = 0; index < tokens.size(); ++index) { parseStatement(tokens[index], statements); }
+        return statements;
+    }
+
+    std::vector<Statement> Parser::parseTokensParallel(const TokenStream &tokens, std::size_t threadCount, std::size_t batchSize) {
+        if(threadCount == 0) { threadCount = std::max(1U, std::thread::hardware_concurrency()); }
+        batchSize = std::max(batchSize, std::size_t{1});
+        const auto batchCount = (tokens.size() + batchSize - 1) / batchSize;
+        if(threadCount == 1 || batchCount < 2) { return parseTokens(tokens); }
+        threadCount = std::min(threadCount, batchCount);
+
+        struct Batch {
+            std::vector<Statement> statements;  ///< The statements of the batch, parsed up to the first error.
+            std::exception_ptr error;           ///< The error that stopped the batch, if any.
+        };
+        std::vector<Batch> batches(batchCount);
+        std::atomic<std::size_t> nextBatch{0};
+        const auto work = [&, this] {
+            Arena arena;
+            Parser worker{*this, _arena != nullptr ? &arena : nullptr};
+            for(auto batch = nextBatch++; batch < batchCount; batch = nextBatch++) {
+                const auto begin = batch * batchSize;
+                const auto end = std::min(begin + batchSize, tokens.size());
+                auto &result = batches[batch];
+                result.statements.reserve(end - begin);
+                try {
+                    for(auto index = begin; index < end; ++index) { worker.parseStatement(tokens[index], result.statements); }
+                } catch(...) { result.error = std::current_exception(); }
+            }
+            return arena;
+        };
+        std::vector<std::future<Arena>> workers;
+        workers.reserve(threadCount - 1);
+        for(std::size_t thread = 1; thread < threadCount; ++thread) { workers.emplace_back(std::async(std::launch::async, work)); }
+        auto arena = work();
+        for(auto &worker : workers) {
+            auto workerArena = worker.get();
+            if(_arena != nullptr) { _arena->absorb(std::move(workerArena)); }
+        }
+        if(_arena != nullptr) { _arena->absorb(std::move(arena)); }
+
+        std::vector<Statement> statements;
+        statements.reserve(tokens.size());
+        for(auto &batch : batches) {
+            if(batch.error) [[unlikely]] { std::rethrow_exception(batch.error); }
+            std::ranges::move(batch.statements, std::back_inserter(statements));
+        }
+        return statements;
+    }
+
+    std::vector<Statement> Parser::parse(TokenStream &tokens, std::vector<Statement> previous, const SourceEdit &edit) {
+        const auto from = tokens.tokens().front().getFileId();
+        auto relex = tokenizer.tokenize(tokens, edit);
+        const auto to = relex.tokens.tokens().front().getFileId();
+        const SourceShift moved{from, to, SourceManager::get(from).text, SourceManager::get(to).text, edit.shift()};
+        return reparse(tokens, std::move(previous), std::move(relex), moved);
+    }
+
+    std::vector<Statement> Parser::parse(TokenStream &tokens, std::vector<Statement> previous, const std::string_view &input,
+                                         const SourceEdit &edit) {
+        const auto fileId = tokens.tokens().front().getFileId();
+        const auto oldText = SourceManager::get(fileId).text;
+        auto relex = tokenizer.tokenize(tokens, input, edit);
+        return reparse(tokens, std::move(previous), std::move(relex), {fileId, fileId, oldText, input, edit.shift()});
+    }
+
+    std::vector<Statement> Parser::reparse(TokenStream &tokens, std::vector<Statement> previous, RelexResult relex, const SourceShift &moved) {
+        const SourceShift kept{moved.from, moved.to, moved.fromText, moved.toText, 0};
+        std::vector<Statement> statements;
+        statements.reserve(relex.tokens.size());
+        for(std::size_t index = 0; index < relex.relexBegin; ++index) {
+            previous[index].rebase(kept);
+            statements.emplace_back(std::move(previous[index]));
+        }
+        for(auto index = relex.relexBegin; index < relex.relexEnd; ++index) { parseStatement(relex.tokens[index], statements); }
+        for(auto index = relex.previousRelexEnd; index < previous.size(); ++index) {
+            previous[index].rebase(moved);
+            statements.emplace_back(std::move(previous[index]));
         }
+        tokens = std::move(relex.tokens);
         return statements;
     }
 
+    void Parser::parseStatement(TokenSpan statement, std::vector<Statement> &statements) {
+        currentStatement = statement;
+        if(!currentStatement.empty() && currentStatement.back().getType() == eofTokenType) {
+            currentStatement = currentStatement.first(currentStatement.size() - 1);
+        }
+        tokenSize = currentStatement.size();
+        position = 0;
+        if(tokenSize == 0) {
+            statements.emplace_back(Token{}, StrViewVec{});
+            return;
+        }
+        emplaceStatement(statements);
+        auto root = position < tokenSize ? parseExpression() : nullptr;
+        if(root && keyword.getType() == TokenType::K_VAR) { root = makeDeclaration(std::move(root)); }
+        statements.back().set_root(std::move(root));
+    }
+
+    NodePtr<ASTNode> Parser::makeDeclaration(NodePtr<ASTNode> expression) {
+        // Returns the operands of expression if it is a binary op expression, nullptr and expression otherwise.
+        const auto split = [](NodePtr<ASTNode> &node, const std::string_view op) -> std::pair<NodePtr<ASTNode>, NodePtr<ASTNode>> {
+            if(node->getKind() != NodeKind::BinaryExpression) { return {std::move(node), nullptr}; }
+            auto &binary = static_cast<BinaryExpressionNode &>(*node);
+            if(binary.getOp() != op) { return {std::move(node), nullptr}; }
+            return {binary.takeLeft(), binary.takeRight()};
+        };
+        auto [declared, initializers] = split(expression, "=");
+        auto [names, type] = split(declared, ":");
+        return makeNode<DeclarationNode>(keyword, std::move(names), std::move(type), std::move(initializers));
+    }
+
     void Parser::emplaceStatement(std::vector<Statement> &statements) {
         Token token{};
-        StringVec data;
-        const auto &tokensFront = currentStatement->front();
+        StrViewVec data;
+        std::size_t signatureEnd = tokenSize;
+        const auto &tokensFront = currentStatement.front();
         using enum TokenType;
         if((tokensFront.getType() == OPEN_CUR_PARENTESIS || tokensFront.getType() == CLOSE_CUR_PARENTESIS ||
             tokensFront.getType() == K_BREAK) &&
@@ -44,16 +205,22 @@ namespace vnd {
         if(fst) {
             token = tokensFront;
             position++;
-            if(token.getType() == K_FUN) { data = extractFunData(); }
+            if(token.getType() == K_FUN) {
+                auto signature = FunctionSignature::parse(currentStatement);
+                data = std::move(signature.returnTypes);
+                signatureEnd = signature.returnTypesBegin;
+            }
         }
         if(snd) {
-            const auto tokensSize = currentStatement->size();
-            if(tokensSize < bracketPosition || currentStatement->at(tokensSize - bracketPosition).getValue() != "{") {
+            const auto tokensSize = currentStatement.size();
+            if(tokensSize < bracketPosition || currentStatement[tokensSize - bracketPosition].getValue() != "{") {
                 throw ParserException(tokensFront);
             }
             tokenSize--;
         }
-        statements.emplace_back(token, data);
+        // The return types of a fun statement are not part of its expression.
+        tokenSize = std::min(tokenSize, signatureEnd);
+        statements.emplace_back(token, std::move(data));
         keyword = token;
     }
 
@@ -61,52 +228,29 @@ namespace vnd {
         if(position < tokenSize - 1) { position++; }
     }
 
-    const std::vector<StrViewVec> Parser::operatorPrecedence = {{","},
-                                                                {":"},
-                                                                {"=", "+=", "-=", "*=", "/=", "^=", "%="},
-                                                                {"||"},
-                                                                {"&&"},
-                                                                {"==", "!="},
-                                                                {"<", "<=", ">", ">="},
-                                                                {"+", "-"},
-                                                                {"*", "/"},
-                                                                {"^", "%"},
-                                                                {"."}};
-    const std::vector<TokenType> Parser::types = {TokenType::TYPE_I8,   TokenType::TYPE_I16,    TokenType::TYPE_I32, TokenType::TYPE_I64,
-                                                  TokenType::TYPE_U8,   TokenType::TYPE_U16,    TokenType::TYPE_U32, TokenType::TYPE_U64,
-                                                  TokenType::TYPE_F32,  TokenType::TYPE_F64,    TokenType::TYPE_C32, TokenType::TYPE_C64,
-                                                  TokenType::TYPE_CHAR, TokenType::TYPE_STRING, TokenType::TYPE_BOOL};
-
-    const Token &Parser::getCurrentToken() const { return currentStatement->at(position); }
-    TokenType Parser::getCurrentTokenType() const { return currentStatement->at(position).getType(); }
+    const Token &Parser::getCurrentToken() const {
+        if(position >= currentStatement.size()) [[unlikely]] { throw std::out_of_range("Parser: token position out of range"); }
+        return currentStatement[position];
+    }
+    TokenType Parser::getCurrentTokenType() const { return getCurrentToken().getType(); }
     bool Parser::isCurrentTokenType(const TokenType &type) const { return getCurrentTokenType() == type; }
     std::size_t Parser::getUnaryOperatorPrecedence(const Token &token) noexcept {
-        if(const auto &tokenValue = token.getValue();
-           tokenValue == "+" || tokenValue == "-" || tokenValue == "!" || tokenValue == "++" || tokenValue == "--") {
-            return operatorPrecedence.size() + 1;
+        using enum TokenType;
+        switch(token.getType()) {
+        case PLUS:
+        case MINUS:
+        case NOT:
+        case PLUSPLUS:
+        case MINUSMINUS:
+            return unaryPrecedence;
+        default:
+            return 0;
         }
-        return 0;
-    }
-
-    std::size_t Parser::adjustPrecedenceForVar(const std::string_view &tokenValue, std::size_t precedence) noexcept {
-        if(tokenValue == ",") { precedence++; }
-        if(tokenValue == ":") { precedence--; }
-        if(tokenValue == "=") { precedence -= 2; }
-        return precedence;
     }
 
     std::size_t Parser::getOperatorPrecedence(const Token &token, const TokenType &type) noexcept {
-        const auto &tokenValue = token.getValue();
-        std::size_t precedence = 0;
-
-        for(const auto &itm : operatorPrecedence) {
-            precedence++;
-            if(std::ranges::find(itm, tokenValue) != itm.end()) {
-                if(type == TokenType::K_VAR) { precedence = adjustPrecedenceForVar(tokenValue, precedence); }
-                return precedence;
-            }
-        }
-        return 0;
+        const auto &table = type == TokenType::K_VAR ? declarationPrecedence : operatorPrecedence;
+        return table[C_ST(token.getType())];
     }
 #ifndef __llvm__
     template <typename T> T Parser::handle_from_chars_error(const std::from_chars_result &result, std::string_view str) {
@@ -195,43 +339,86 @@ namespace vnd {
         return std::complex<T>(0, convertToDouble<T>(str));
     }
 
-    std::unique_ptr<ASTNode> Parser::parsePrimaryInteger(const Token &currentToken, std::string_view currentValue) {
+    NodePtr<ASTNode> Parser::parsePrimaryInteger(const Token &currentToken, std::string_view currentValue) {
         consumeToken();
         if(currentValue.starts_with("#o") || currentValue.starts_with("#O")) {
             currentValue.remove_prefix(2);
-            return MAKE_UNIQUE(VND_NUM_INT, convertToIntformOct(currentValue), currentToken, NumberNodeType::Integer);
+            return makeNode<VND_NUM_INT>(convertToIntformOct(currentValue), currentToken, NumberNodeType::Integer);
         }
         if(currentValue.starts_with("#")) {
             currentValue.remove_prefix(1);
-            return MAKE_UNIQUE(VND_NUM_INT, convertToIntformExa(currentValue), currentToken, NumberNodeType::Integer);
+            return makeNode<VND_NUM_INT>(convertToIntformExa(currentValue), currentToken, NumberNodeType::Integer);
         }
-        return MAKE_UNIQUE(VND_NUM_INT, convertToInt(currentValue), currentToken, NumberNodeType::Integer);
+        return makeNode<VND_NUM_INT>(convertToInt(currentValue), currentToken, NumberNodeType::Integer);
     }
-    std::unique_ptr<ASTNode> Parser::parsePrimaryDouble(const Token &currentToken, const std::string_view &currentValue) {
+    NodePtr<ASTNode> Parser::parsePrimaryDouble(const Token &currentToken, const std::string_view &currentValue) {
         consumeToken();
         if(currentValue.ends_with("if")) {
-            return MAKE_UNIQUE(VND_NUM_CFLOAT, convertToImg<float>(currentValue), currentToken, NumberNodeType::ImaginaryFloat);
+            return makeNode<VND_NUM_CFLOAT>(convertToImg<float>(currentValue), currentToken, NumberNodeType::ImaginaryFloat);
         }
         if(currentValue.ends_with("i")) {
-            return MAKE_UNIQUE(VND_NUM_CDOUBLE, convertToImg<double>(currentValue), currentToken, NumberNodeType::Imaginary);
+            return makeNode<VND_NUM_CDOUBLE>(convertToImg<double>(currentValue), currentToken, NumberNodeType::Imaginary);
         }
         if(currentValue.ends_with("f")) {
-            return MAKE_UNIQUE(VND_NUM_FLOAT, convertToDouble<float>(currentValue), currentToken, NumberNodeType::Float);
+            return makeNode<VND_NUM_FLOAT>(convertToDouble<float>(currentValue), currentToken, NumberNodeType::Float);
         }
-        return MAKE_UNIQUE(VND_NUM_DOUBLE, convertToDouble<double>(currentValue), currentToken, NumberNodeType::Double);
+        return makeNode<VND_NUM_DOUBLE>(convertToDouble<double>(currentValue), currentToken, NumberNodeType::Double);
     }
+    /**
+     * @brief Links an index to the variable, type or index it follows.
+     * @param owner The node receiving the index.
+     * @param index The index.
+     */
+    static void attachIndex(ASTNode &owner, NodePtr<IndexNode> index) noexcept {
+        switch(owner.getType()) {
+        case NodeType::Type:
+            static_cast<TypeNode &>(owner).set_index(std::move(index));
+            break;
+        case NodeType::Index:
+            static_cast<IndexNode &>(owner).set_index(std::move(index));
+            break;
+        default:
+            static_cast<VariableNode &>(owner).set_index(std::move(index));
+            break;
+        }
+    }
+
+    void Parser::requireFollowingToken(const Token &token) const {
+        // consumeToken() stays on the last token, which would be read again as the start of the nested expression.
+        if(position + 1 >= tokenSize) [[unlikely]] { throw ParserException(token); }
+    }
+
+    void Parser::openExpression(const FrameKind kind, const Token &token, NodePtr<ASTNode> node, ASTNode *owner) {
+        expressionFrames.emplace_back(kind, 0, &token, std::move(node), owner);
+        expressionFrames.emplace_back(FrameKind::Binary, 0, nullptr, nullptr, nullptr);
+    }
+
+    NodePtr<ASTNode> Parser::parseOperand() {
+        // Prefix operators bind tighter than every binary operator: each one waits for the single operand after it.
+        while(true) {
+            const Token &currentToken = getCurrentToken();
+            const auto unaryOperatorPrecedence = getUnaryOperatorPrecedence(currentToken);
+            if(unaryOperatorPrecedence == 0 || unaryOperatorPrecedence < expressionFrames.back().precedence) { break; }
+            requireFollowingToken(currentToken);
+            consumeToken();
+            expressionFrames.emplace_back(FrameKind::Unary, 0, &currentToken, nullptr, nullptr);
+            expressionFrames.emplace_back(FrameKind::Binary, unaryOperatorPrecedence, nullptr, nullptr, nullptr);
+        }
+        return parsePrimary();
+    }
+
     // NOLINTNEXTLINE(*-function-cognitive-complexity)
-    std::unique_ptr<ASTNode> Parser::parsePrimary() {
+    NodePtr<ASTNode> Parser::parsePrimary() {
         using enum NumberNodeType;
         const Token &currentToken = getCurrentToken();
         const auto &currentType = getCurrentTokenType();
         const auto &currentValue = currentToken.getValue();
 
-        if(std::ranges::find(types, currentType) != types.end()) {
+        if(typeTokens[C_ST(currentType)]) {
             consumeToken();
-            auto node = MAKE_UNIQUE(TypeNode, currentToken);
-            parseIndex<TypeNode>(node);
-            return node;
+            auto node = makeNode<TypeNode>(currentToken);
+            auto &owner = *node;
+            return parseIndex(std::move(node), owner);
         } else if(currentType == TokenType::INTEGER) {
             return parsePrimaryInteger(currentToken, currentValue);
         } else if(currentType == TokenType::DOUBLE) {
@@ -240,136 +427,162 @@ namespace vnd {
             consumeToken();
             auto value = true;
             if(currentValue == "false") { value = false; }
-            return MAKE_UNIQUE(LiteralNode<bool>, value, currentToken, NodeType::Boolean);
+            return makeNode<LiteralNode<bool>>(value, currentToken, NodeType::Boolean);
         } else if(currentType == TokenType::CHAR) {
             consumeToken();
-            return MAKE_UNIQUE(LiteralNode<char>, currentValue.at(0), currentToken, NodeType::Char);
+            return makeNode<LiteralNode<char>>(currentValue.at(0), currentToken, NodeType::Char);
         } else if(currentType == TokenType::STRING) {
             consumeToken();
-            return MAKE_UNIQUE(LiteralNode<std::string_view>, currentValue, currentToken, NodeType::String);
+            return makeNode<LiteralNode<std::string_view>>(currentValue, currentToken, NodeType::String);
         } else if(currentType == TokenType::IDENTIFIER) {
             consumeToken();
-            auto node = MAKE_UNIQUE(VariableNode, currentValue, currentToken);
-            if(!parseCall(node)) { parseIndex<VariableNode>(node); }
-            return node;
+            auto node = makeNode<VariableNode>(currentValue, currentToken);
+            if(!isCurrentTokenType(TokenType::OPEN_PARENTESIS)) {
+                auto &owner = *node;
+                return parseIndex(std::move(node), owner);
+            }
+            const Token &open = getCurrentToken();
+            requireFollowingToken(open);
+            consumeToken();
+            if(isCurrentTokenType(TokenType::CLOSE_PARENTESIS)) {
+                consumeToken();
+                node->set_call();
+                return node;
+            }
+            openExpression(FrameKind::Call, open, std::move(node));
+            return nullptr;
         } else if(currentType == TokenType::K_NULLPTR) {
             consumeToken();
-            return MAKE_UNIQUE(NullptrNode, currentToken);
+            return makeNode<NullptrNode>(currentToken);
         } else if(currentValue == "(") {
+            requireFollowingToken(currentToken);
             consumeToken();
-            auto expression = parseExpression();
-            if(getCurrentToken().getValue() == ")") {
-                consumeToken();
-                return expression;
-            }
-            // Handle error: mismatched parentheses
-            throw ParserException(currentToken);
+            openExpression(FrameKind::Parenthesis, currentToken);
+            return nullptr;
         } else if(currentValue == "{") {
-            auto token = getCurrentToken();
+            requireFollowingToken(currentToken);
             consumeToken();
             if(isCurrentTokenType(TokenType::CLOSE_CUR_PARENTESIS)) {
                 consumeToken();
-                return MAKE_UNIQUE(ArrayNode, nullptr, token);
+                return makeNode<ArrayNode>(nullptr, currentToken);
             }
-            auto elements = parseExpression();
-            if(!isCurrentTokenType(TokenType::CLOSE_CUR_PARENTESIS)) { throw ParserException(getCurrentToken()); }
-            consumeToken();
-            return MAKE_UNIQUE(ArrayNode, std::move(elements), token);
+            openExpression(FrameKind::Array, currentToken);
+            return nullptr;
         } else [[unlikely]] {
             // Handle error: unexpected token
             throw ParserException(currentToken);
         }
     }
-    std::unique_ptr<ASTNode> Parser::parseUnary(std::size_t parentPrecendence) {
-        const auto &currentToken = getCurrentToken();
-        const auto unaryOperatorPrecedence = getUnaryOperatorPrecedence(currentToken);
-        if(unaryOperatorPrecedence != 0 && unaryOperatorPrecedence >= parentPrecendence) {
-            consumeToken();
-            auto operand = parseExpression(unaryOperatorPrecedence);
-            return MAKE_UNIQUE(UnaryExpressionNode, currentToken, std::move(operand));
-        } else {
-            return parsePrimary();
-        }
-    }
-    std::unique_ptr<ASTNode> Parser::parseBinary(std::size_t parentPrecendence) {
-        auto left = parseUnary(parentPrecendence);
-        while(true) {
-            const auto precedence = getOperatorPrecedence(getCurrentToken(), keyword.getType());
-            if(precedence == 0 || precedence <= parentPrecendence) { break; }
-            const Token &opToken = getCurrentToken();
-            consumeToken();
-            auto right = parseExpression(precedence);
-            left = MAKE_UNIQUE(BinaryExpressionNode, opToken, std::move(left), std::move(right));
-        }
-        return left;
-    }
 
-    std::unique_ptr<ASTNode> Parser::parseExpression(std::size_t parentPrecendence) { return parseBinary(parentPrecendence); }
-
-    template <typename T> void Parser::parseIndex(const std::unique_ptr<T> &node) {
+    // NOLINTNEXTLINE(*-function-cognitive-complexity)
+    NodePtr<ASTNode> Parser::parseExpression() {
         using enum vnd::TokenType;
-        auto token = getCurrentToken();
-        if(token.getType() != OPEN_SQ_PARENTESIS) { return; }
-        consumeToken();
-        if(isCurrentTokenType(CLOSE_SQ_PARENTESIS)) {
-            consumeToken();
-            auto index = MAKE_UNIQUE(IndexNode, nullptr, token);
-            if(!parseArray(index)) { parseIndex<IndexNode>(index); }
-            node->set_index(vnd_move_always_even_const(index));
-            return;
+        expressionFrames.clear();
+        expressionFrames.emplace_back(FrameKind::Binary, 0, nullptr, nullptr, nullptr);
+        NodePtr<ASTNode> value;
+        while(true) {
+            // An empty value means the frame on top is a Binary frame waiting for its first operand.
+            if(value == nullptr) {
+                value = parseOperand();
+                if(value == nullptr) { continue; }
+            }
+            auto &frame = expressionFrames.back();
+            switch(frame.kind) {
+            case FrameKind::Binary: {
+                if(frame.token != nullptr) { value = makeNode<BinaryExpressionNode>(*frame.token, std::move(frame.node), std::move(value)); }
+                const Token &opToken = getCurrentToken();
+                const auto precedence = getOperatorPrecedence(opToken, keyword.getType());
+                if(precedence != 0 && precedence > frame.precedence) {
+                    // Operators of the same precedence close the frame first, so they associate to the left.
+                    frame.token = &opToken;
+                    frame.node = std::move(value);
+                    consumeToken();
+                    expressionFrames.emplace_back(FrameKind::Binary, precedence, nullptr, nullptr, nullptr);
+                    continue;
+                }
+                expressionFrames.pop_back();
+                if(expressionFrames.empty()) { return value; }
+                break;
+            }
+            case FrameKind::Unary:
+                value = makeNode<UnaryExpressionNode>(*frame.token, std::move(value));
+                expressionFrames.pop_back();
+                break;
+            case FrameKind::Parenthesis:
+                // Handle error: mismatched parentheses
+                if(!isCurrentTokenType(CLOSE_PARENTESIS)) { throw ParserException(*frame.token); }
+                consumeToken();
+                expressionFrames.pop_back();
+                break;
+            case FrameKind::Array:
+                if(!isCurrentTokenType(CLOSE_CUR_PARENTESIS)) { throw ParserException(getCurrentToken()); }
+                consumeToken();
+                value = makeNode<ArrayNode>(std::move(value), *frame.token);
+                expressionFrames.pop_back();
+                break;
+            case FrameKind::Call: {
+                if(!isCurrentTokenType(CLOSE_PARENTESIS)) { throw ParserException(getCurrentToken()); }
+                consumeToken();
+                auto node = std::move(frame.node);
+                expressionFrames.pop_back();
+                static_cast<VariableNode &>(*node).set_call(std::move(value));
+                value = std::move(node);
+                break;
+            }
+            case FrameKind::Index: {
+                // if(!isCurrentTokenType(CLOSE_SQ_PARENTESIS)) { throw ParserException(getCurrentToken()); }
+                consumeToken();
+                auto index = makeNode<IndexNode>(std::move(value), *frame.token);
+                auto &added = *index;
+                attachIndex(*frame.owner, std::move(index));
+                auto node = std::move(frame.node);
+                expressionFrames.pop_back();
+                value = parseIndex(std::move(node), added);
+                break;
+            }
+            case FrameKind::IndexArray: {
+                if(!isCurrentTokenType(CLOSE_CUR_PARENTESIS)) { throw ParserException(getCurrentToken()); }
+                consumeToken();
+                static_cast<IndexNode &>(*frame.owner).set_array(makeNode<ArrayNode>(std::move(value), *frame.token));
+                value = std::move(frame.node);
+                expressionFrames.pop_back();
+                break;
+            }
+            }
         }
-        auto elements = parseExpression();
-        // if(!isCurrentTokenType(CLOSE_SQ_PARENTESIS)) { throw ParserException(getCurrentToken()); }
-        consumeToken();
-        auto index = MAKE_UNIQUE(IndexNode, std::move(elements), token);
-        if(!parseArray(index)) { parseIndex<IndexNode>(index); }
-        node->set_index(vnd_move_always_even_const(index));
     }
 
-    bool Parser::parseArray(const std::unique_ptr<IndexNode> &node) {
+    NodePtr<ASTNode> Parser::parseIndex(NodePtr<ASTNode> node, ASTNode &owner) {
         using enum vnd::TokenType;
-        auto token = getCurrentToken();
-        if(token.getType() != OPEN_CUR_PARENTESIS) { return false; }
-        consumeToken();
-        if(isCurrentTokenType(CLOSE_CUR_PARENTESIS)) {
+        auto *current = &owner;
+        while(true) {
+            // An index is followed either by an array literal or by the next index, never both.
+            if(current->getType() == NodeType::Index && isCurrentTokenType(OPEN_CUR_PARENTESIS)) {
+                const Token &token = getCurrentToken();
+                requireFollowingToken(token);
+                consumeToken();
+                if(isCurrentTokenType(CLOSE_CUR_PARENTESIS)) {
+                    consumeToken();
+                    static_cast<IndexNode *>(current)->set_array(makeNode<ArrayNode>(nullptr, token));
+                    return node;
+                }
+                openExpression(FrameKind::IndexArray, token, std::move(node), current);
+                return nullptr;
+            }
+            if(!isCurrentTokenType(OPEN_SQ_PARENTESIS)) { return node; }
+            const Token &token = getCurrentToken();
+            requireFollowingToken(token);
             consumeToken();
-            node->set_array(MAKE_UNIQUE(ArrayNode, nullptr, token));
-            return true;
-        }
-        auto elements = parseExpression();
-        if(!isCurrentTokenType(CLOSE_CUR_PARENTESIS)) { throw ParserException(getCurrentToken()); }
-        consumeToken();
-        node->set_array(MAKE_UNIQUE(ArrayNode, std::move(elements), token));
-        return true;
-    }
-
-    bool Parser::parseCall(const std::unique_ptr<VariableNode> &node) {
-        using enum vnd::TokenType;
-        if(!isCurrentTokenType(OPEN_PARENTESIS)) { return false; }
-        consumeToken();
-        if(isCurrentTokenType(CLOSE_PARENTESIS)) {
+            if(!isCurrentTokenType(CLOSE_SQ_PARENTESIS)) {
+                openExpression(FrameKind::Index, token, std::move(node), current);
+                return nullptr;
+            }
             consumeToken();
-            node->set_call();
-            return true;
+            auto index = makeNode<IndexNode>(nullptr, token);
+            auto *added = index.get();
+            attachIndex(*current, std::move(index));
+            current = added;
         }
-        auto elements = parseExpression();
-        if(!isCurrentTokenType(CLOSE_PARENTESIS)) { throw ParserException(getCurrentToken()); }
-        consumeToken();
-        node->set_call(std::move(elements));
-        return true;
-    }
-
-    StringVec Parser::extractFunData() {
-        StringVec result;
-        const auto offset = (currentStatement->back().isType(eofTokenType) ? 3 : 2);
-        if(currentStatement->size() <= C_ST(offset)) { return {}; }
-        auto iter = std::prev(currentStatement->end(), offset);
-        while(iter->getType() != TokenType::CLOSE_PARENTESIS && std::distance(currentStatement->begin(), iter) >= 3) {
-            result.emplace(result.begin(), iter->getValue());
-            iter = currentStatement->erase(iter);
-            --iter;
-        }
-        return result;
     }
 }  // namespace vnd
 DISABLE_WARNINGS_POP()
@@ -0,0 +1,55 @@
+// NOLINTBEGIN(*-include-cleaner)
+#include "Vandior/transpiler/BuildManifest.hpp"
+
+namespace vnd {
+    BuildManifest BuildManifest::load(const fs::path &path) {
+        BuildManifest manifest;
+        std::ifstream file(path);
+        if(!file.is_open()) { return manifest; }
+        std::string line;
+        if(constexpr std::string_view header = "generator "; std::getline(file, line) && line.starts_with(header)) {
+            manifest._generator = line.substr(header.size());
+        } else {
+            // A manifest without a generator line is treated as written by an unknown generator.
+            file.clear();
+            file.seekg(0);
+        }
+        while(std::getline(file, line)) {
+            std::istringstream fields(line);
+            std::string name;
+            Entry entry;
+            if(fields >> name >> std::hex >> entry.sourceHash >> entry.codeHash) [[likely]] {
+                manifest._entries.insert_or_assign(std::move(name), entry);
+            }
+        }
+        return manifest;
+    }
+
+    bool BuildManifest::save(const fs::path &path) const {
+        fmt::memory_buffer out;
+        fmt::format_to(fmt::appender(out), "generator {}\n", _generator);
+        for(const auto &[name, entry] : _entries) {
+            fmt::format_to(fmt::appender(out), "{} {:016x} {:016x}\n", name, entry.sourceHash, entry.codeHash);
+        }
+        return FileCreationResult::createFileFromPath(path, std::string_view{out.data(), out.size()}).success();
+    }
+
+    const BuildManifest::Entry *BuildManifest::find(const std::string_view name) const noexcept {
+        const auto entry = _entries.find(name);
+        return entry != _entries.end() ? &entry->second : nullptr;
+    }
+
+    void BuildManifest::set(const std::string_view name, const Entry &entry) {
+        if(const auto found = _entries.find(name); found != _entries.end()) {
+            found->second = entry;
+        } else {
+            _entries.emplace(name, entry);
+        }
+    }
+
+    void BuildManifest::erase(const std::string_view name) {
+        if(const auto found = _entries.find(name); found != _entries.end()) { _entries.erase(found); }
+    }
+}  // namespace vnd
+
+// NOLINTEND(*-include-cleaner)
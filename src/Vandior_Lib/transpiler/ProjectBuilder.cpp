@@ -50,6 +50,16 @@ namespace vnd {
     // Getter per ottenere il percorso del file principale .cpp
     std::optional<fs::path> ProjectBuilder::getMainOutputFilePath() const { return _mainOutputFilePath; }
 
+    std::optional<fs::path> ProjectBuilder::getSourceFilePath(const std::string_view &fileName) const {
+        if(!_vnSrcFolder.has_value()) { return std::nullopt; }
+        return _vnSrcFolder.value() / fileName;
+    }
+
+    std::optional<fs::path> ProjectBuilder::getManifestFilePath() const {
+        if(!_vnBuildFolder.has_value()) { return std::nullopt; }
+        return _vnBuildFolder.value() / fs::path(_filename).replace_extension(".manifest").filename();
+    }
+
     // Metodo per creare la cartella 'vnbuild'
     bool ProjectBuilder::createBuildFolder() {
         const auto resultFolderCreation = vnd::FolderCreationResult::createFolderNextToFile(_filename.data(), VANDIOR_BUILDFOLDER);
@@ -119,7 +129,7 @@ elseif (CMAKE_CXX_COMPILER_ID STREQUAL "MSVC")
     set_property(DIRECTORY PROPERTY VS_STARTUP_PROJECT ${PROJECT_NAME})
 endif()
 )";
-            const auto result = vnd::FileCreationResult::createFile(_vnBuildFolder.value(), "CMakeLists.txt", outfile);
+            const auto result = vnd::FileCreationResult::createFile(_vnBuildFolder.value(), "CMakeLists.txt", outfile.view());
 
             return result.success();
         }
@@ -1,5 +1,5 @@
 // clang-format off
-// NOLINTBEGIN(*-include-cleaner, *-easily-swappable-parameters, *-unused-variable, *-branch-clone, *-no-recursion,*-identifier-length)
+// NOLINTBEGIN(*-include-cleaner, *-easily-swappable-parameters, *-unused-variable, *-branch-clone, *-identifier-length)
 // clang-format on
 #include "Vandior/transpiler/Transpiler.hpp"
 using namespace std::string_view_literals;
@@ -13,9 +13,6 @@ int main() {
 }
 )"sv;
 namespace vnd {
-    static inline constexpr std::size_t INITIAL_BUFFER_SIZE = 100;
-    static inline constexpr std::size_t INITIAL_TOTAL_BUFFER_SIZE = 1024;
-
     // Simplify handling of std::optional with fallback logging function
     template <typename T> auto Transpiler::getValueOrLog(const std::optional<T> &opt, std::string_view errorMsg) -> T {
         if(opt.has_value()) { return opt.value(); }
@@ -24,7 +21,17 @@ namespace vnd {
     }
 
     Transpiler::Transpiler(const std::string_view &input, const std::string_view &filename, bool createCmakeListsFile)
-      : _filename(filename), _projectBuilder(_filename, createCmakeListsFile), _parser(input, _filename) {
+      : _filename(filename), _projectBuilder(_filename, createCmakeListsFile),
+        _ownedUnit(std::make_unique<CompilationUnit>(std::string{input}, std::string{filename})), _unit(_ownedUnit.get()) {
+        setupProject();
+    }
+
+    Transpiler::Transpiler(CompilationUnit &unit, bool createCmakeListsFile)
+      : _filename(unit.fileName()), _projectBuilder(_filename, createCmakeListsFile), _unit(&unit) {
+        setupProject();
+    }
+
+    void Transpiler::setupProject() {
         _projectBuilder.buildProject();
         _vnBuildFolder = getValueOrLog(_projectBuilder.getBuildFolderPath(), "Failed to get build folder path.");
         _vnBuildSrcFolder = getValueOrLog(_projectBuilder.getSrcFolderPath(), "Failed to get src folder path.");
@@ -33,50 +40,260 @@ namespace vnd {
     void Transpiler::createMockfile() const {
         const auto generatorName = GENERATOR_FULLNAME;
 
-        std::stringstream fileContents;
-        fileContents << FORMAT("// This is an automatically generated file by {}, do not modify.\n", generatorName);
-        fileContents << "// for more information got to https://github.com/Giuseppe-Bianc/Vandior\n";
-        fileContents << fileContent;
+        const auto fileContents = FORMAT("// This is an automatically generated file by {}, do not modify.\n"
+                                         "// for more information got to https://github.com/Giuseppe-Bianc/Vandior\n{}",
+                                         generatorName, fileContent);
         [[maybe_unused]] const auto file_creation_result = FileCreationResult::createFileFromPath(_mainOutputFilePath, fileContents);
     }
     std::string Transpiler::transpile() {
         createMockfile();
-        std::stringstream out;
+        return transpile(_unit->flatAST());
+    }
+
+    /**
+     * @brief Appends text to the output buffer.
+     * @param out The buffer.
+     * @param text The text.
+     */
+    static void append(Transpiler::OutputBuffer &out, const std::string_view text) { out.append(text.data(), text.data() + text.size()); }
+
+    std::string Transpiler::transpile(const FlatAST &ast) {
+        OutputBuffer out;
+        for(std::size_t i = 0; i < ast.statementCount(); ++i) { transpileStatement(ast, i, out); }
+        return fmt::to_string(out);
+    }
+
+    /**
+     * @brief Appends the notice that opens every generated file.
+     * @param out The buffer.
+     */
+    static void appendGeneratedNotice(Transpiler::OutputBuffer &out) {
+        fmt::format_to(fmt::appender(out), "// This is an automatically generated file by {}, do not modify.\n", GENERATOR_FULLNAME);
+        append(out, "// for more information got to https://github.com/Giuseppe-Bianc/Vandior\n");
+    }
+
+    /**
+     * @brief The statements of a top-level fun, from its signature to its closing curly bracket.
+     */
+    struct FunctionRange {
+        std::size_t begin;  ///< The fun statement.
+        std::size_t end;    ///< One past the closing curly bracket, or the statement count if it is missing.
+    };
+
+    /**
+     * @brief Finds the top-level functions by following the nesting of the blocks.
+     * @param ast The statements in flat form.
+     * @return The functions, in source order.
+     */
+    static std::vector<FunctionRange> findFunctions(const FlatAST &ast) {
         using enum TokenType;
-        for(const auto ast = _parser.parse(); const auto &i : ast) {
-            const auto &node = i.get_root();
-            out << transpileKeyword(i.get_token());
-            if(node) {
-                auto code = transpileNode(*node);
-                if(i.get_token().getType() == TokenType::K_VAR) { code = parseDeclaration(code); }
-                out << code;
+        std::vector<FunctionRange> functions;
+        std::size_t depth = 0;
+        for(std::size_t i = 0; i < ast.statementCount(); ++i) {
+            const auto type = ast.statementToken(i).getType();
+            if(type == CLOSE_CUR_PARENTESIS) {
+                if(depth > 0 && --depth == 0 && !functions.empty() && functions.back().end == ast.statementCount()) { functions.back().end = i + 1; }
+                continue;
             }
-            const auto stTknType = i.get_token().getType();
-            if(checkKeyword(stTknType).second) {
-                if(stTknType != K_FUN && stTknType != K_MAIN) {
-                    out << ")";
-                } else if(stTknType == K_FUN) {
-                    out << " ->";
-                    const auto &data = i.get_funData();
-                    if(data.empty()) {
-                        out << " void";
-                    } else if(data.size() == 1) {
-                        out << FORMAT(" {}", mapType(data.front()));
-                    } else {
-                        out << " std::tuple<";
-                        for(const auto &j : i.get_funData()) { out << FORMAT(" {}", mapType(j)); }
-                        out << ">";
-                    }
+            if(depth == 0 && type == K_FUN) { functions.emplace_back(i, ast.statementCount()); }
+            if(type == OPEN_CUR_PARENTESIS || checkKeyword(type).second) { ++depth; }
+        }
+        return functions;
+    }
+
+    /**
+     * @brief Hashes the tokens of a range of statements and the shape of their trees, but not their positions, so
+     * moving a function in the file or editing another one leaves its hash unchanged.
+     * @param ast The statements in flat form.
+     * @param range The statements to hash.
+     * @return The hash.
+     */
+    static std::uint64_t hashStatements(const FlatAST &ast, const FunctionRange &range) {
+        const auto relative = [](const NodeId node, const NodeId base) { return node == noNode ? std::uint64_t{noNode} : std::uint64_t{node - base}; };
+        const auto addText = [](ContentHash &hash, const std::string_view text) { hash.add(text.size()).add(text); };
+        // Nodes are numbered in pre-order, statement after statement, so the nodes of the range are contiguous.
+        NodeId first = noNode;
+        for(auto i = range.begin; i < range.end && first == noNode; ++i) { first = ast.statementRoot(i); }
+        auto last = C_UI32T(ast.size());
+        for(auto i = range.end; i < ast.statementCount() && last == ast.size(); ++i) {
+            if(const auto root = ast.statementRoot(i); root != noNode) { last = root; }
+        }
+        ContentHash hash;
+        for(auto i = range.begin; i < range.end; ++i) {
+            const auto &keyword = ast.statementToken(i);
+            hash.add(C_UI64T(keyword.getType())).add(relative(ast.statementRoot(i), first));
+            addText(hash, keyword.getValue());
+            hash.add(ast.funData(i).size());
+            for(const auto &type : ast.funData(i)) { addText(hash, type); }
+        }
+        for(auto node = first; node < last; ++node) {
+            const auto &token = ast.token(node);
+            hash.add(C_UI64T(ast.kind(node))).add(C_UI64T(ast.role(node))).add(C_UI64T(token.getType())).add(C_UI64T(ast.isCall(node)));
+            hash.add(relative(ast.firstChild(node), node)).add(relative(ast.nextSibling(node), node));
+            addText(hash, token.getValue());
+        }
+        return hash.value();
+    }
+
+    std::vector<Transpiler::GeneratedFile> Transpiler::transpileUnits(const std::size_t threadCount) {
+        const auto manifestPath = getValueOrLog(_projectBuilder.getManifestFilePath(), "Failed to get manifest file path.");
+        const auto sourcePath = [this](const std::string_view name) {
+            return getValueOrLog(_projectBuilder.getSourceFilePath(name), "Failed to get source file path.");
+        };
+        auto previous = BuildManifest::load(manifestPath);
+        // A file deleted since the last run has to be generated again, whatever the manifest says.
+        std::vector<std::string> missing;
+        for(const auto &name : previous.entries() | std::views::keys) {
+            if(!fs::exists(sourcePath(name))) { missing.emplace_back(name); }
+        }
+        for(const auto &name : missing) { previous.erase(name); }
+
+        // Code written by another generator may differ from what this one writes, so none of it is reused; the entries
+        // still tell which files to delete and which ones already hold the code.
+        auto generator = GENERATOR_FULLNAME;
+        const auto *reusable = previous.generator() == generator ? &previous : nullptr;
+        auto files = transpileUnits(_unit->flatAST(), _mainOutputFilePath.stem().string(), threadCount, reusable);
+        BuildManifest current;
+        current.setGenerator(std::move(generator));
+        for(const auto &file : files) {
+            current.set(file.name, {file.sourceHash, file.codeHash});
+            if(file.reused) { continue; }
+            if(const auto *entry = previous.find(file.name); entry != nullptr && entry->codeHash == file.codeHash) { continue; }
+            [[maybe_unused]] const auto file_creation_result = FileCreationResult::createFileFromPath(sourcePath(file.name), file.code);
+        }
+        // The units of the functions removed since the last run would still be picked up by the C++ build.
+        for(const auto &name : previous.entries() | std::views::keys) {
+            if(current.find(name) == nullptr) { [[maybe_unused]] const auto file_deletion_result = FileDelitionResult::deleteFile(sourcePath(name)); }
+        }
+        if(!current.save(manifestPath)) { LERROR("Failed to save the manifest {}", manifestPath); }
+        return files;
+    }
+
+    std::vector<Transpiler::GeneratedFile> Transpiler::transpileUnits(const FlatAST &ast, const std::string_view baseName, std::size_t threadCount,
+                                                                      const BuildManifest *previous) {
+        using enum TokenType;
+        const auto functions = findFunctions(ast);
+        const auto headerName = FORMAT("{}.hpp", baseName);
+        std::vector<GeneratedFile> files(functions.size() + 2);
+        files[0].name = headerName;
+        files[1].name = FORMAT("{}.cpp", baseName);
+        // Overloads share a name, so every fun after the first of its name gets its ordinal appended after a '-', which
+        // no identifier holds: the second f and a fun named f_2 do not end up in the same file.
+        std::unordered_map<std::string_view, std::size_t> overloads;
+        for(std::size_t i = 0; i < functions.size(); ++i) {
+            const auto root = ast.statementRoot(functions[i].begin);
+            const auto name = root != noNode ? ast.text(root) : std::string_view{};
+            const auto ordinal = ++overloads[name];
+            files[i + 2].name = ordinal == 1 ? FORMAT("{}_{}.cpp", baseName, name) : FORMAT("{}_{}-{}.cpp", baseName, name, ordinal);
+        }
+
+        // The functions are independent of each other: each worker takes the next one until none is left.
+        std::vector<std::exception_ptr> errors(functions.size());
+        std::atomic<std::size_t> nextFunction{0};
+        const auto work = [&, this] {
+            OutputBuffer out;
+            for(auto function = nextFunction++; function < functions.size(); function = nextFunction++) {
+                auto &file = files[function + 2];
+                file.sourceHash = hashStatements(ast, functions[function]);
+                if(const auto *entry = previous != nullptr ? previous->find(file.name) : nullptr; entry != nullptr && entry->sourceHash == file.sourceHash) {
+                    file.codeHash = entry->codeHash;
+                    file.reused = true;
+                    continue;
                 }
-                out << " {";
+                out.clear();
+                try {
+                    appendGeneratedNotice(out);
+                    fmt::format_to(fmt::appender(out), "#include \"{}\"\n\n", headerName);
+                    for(auto i = functions[function].begin; i < functions[function].end; ++i) { transpileStatement(ast, i, out); }
+                    file.code = fmt::to_string(out);
+                    file.codeHash = ContentHash{}.add(file.code).value();
+                } catch(...) { errors[function] = std::current_exception(); }
+            }
+        };
+        if(threadCount == 0) { threadCount = std::max(1U, std::thread::hardware_concurrency()); }
+        threadCount = std::min(threadCount, std::max(functions.size(), std::size_t{1}));
+        std::vector<std::future<void>> workers;
+        workers.reserve(threadCount - 1);
+        for(std::size_t thread = 1; thread < threadCount; ++thread) { workers.emplace_back(std::async(std::launch::async, work)); }
+
+        // Meanwhile the calling thread writes the header and the main file from the top-level statements.
+        OutputBuffer header;
+        OutputBuffer main;
+        appendGeneratedNotice(header);
+        append(header, "#pragma once\n\n#include <cstdint>\n#include <string_view>\n#include <tuple>\n\n");
+        appendGeneratedNotice(main);
+        fmt::format_to(fmt::appender(main), "#include \"{}\"\n\n", headerName);
+        std::size_t depth = 0;
+        auto function = functions.begin();
+        for(std::size_t i = 0; i < ast.statementCount(); ++i) {
+            if(function != functions.end() && i == function->begin) {
+                transpileFunctionSignature(ast, i, header);
+                append(header, ";\n");
+                i = function->end - 1;
+                ++function;
+                continue;
             }
-            out << "\n";
+            const auto type = ast.statementToken(i).getType();
+            if(depth == 0 && type == K_VAR) {
+                // Emitted in place rather than through transpileStatement, so that no line break has to be trimmed.
+                append(header, "inline ");
+                append(header, transpileKeyword(ast.statementToken(i)));
+                if(const auto node = ast.statementRoot(i); node != noNode) { transpileNode(ast, node, header); }
+                append(header, ";\n");
+                continue;
+            }
+            if(type == CLOSE_CUR_PARENTESIS && depth > 0) { --depth; }
+            if(type == OPEN_CUR_PARENTESIS || checkKeyword(type).second) { ++depth; }
+            transpileStatement(ast, i, main);
+        }
+        files[0].code = fmt::to_string(header);
+        files[1].code = fmt::to_string(main);
+        for(auto &file : files | std::views::take(2)) { file.codeHash = ContentHash{}.add(file.code).value(); }
+
+        work();
+        for(auto &worker : workers) { worker.get(); }
+        for(const auto &error : errors) {
+            if(error) [[unlikely]] { std::rethrow_exception(error); }
+        }
+        return files;
+    }
+
+    void Transpiler::transpileStatement(const FlatAST &ast, const std::size_t statement, OutputBuffer &out) {
+        using enum TokenType;
+        const auto &keyword = ast.statementToken(statement);
+        const auto stTknType = keyword.getType();
+        if(stTknType == K_FUN) {
+            transpileFunctionSignature(ast, statement, out);
+            append(out, " {\n");
+            return;
+        }
+        append(out, transpileKeyword(keyword));
+        if(const auto node = ast.statementRoot(statement); node != noNode) { transpileNode(ast, node, out); }
+        if(checkKeyword(stTknType).second) {
+            if(stTknType != K_MAIN) { append(out, ")"); }
+            append(out, " {");
+        }
+        append(out, "\n");
+    }
+
+    void Transpiler::transpileFunctionSignature(const FlatAST &ast, const std::size_t statement, OutputBuffer &out) {
+        append(out, transpileKeyword(ast.statementToken(statement)));
+        if(const auto node = ast.statementRoot(statement); node != noNode) { transpileNode(ast, node, out); }
+        append(out, " ->");
+        const auto &data = ast.funData(statement);
+        if(data.empty()) {
+            append(out, " void");
+        } else if(data.size() == 1) {
+            fmt::format_to(fmt::appender(out), " {}", mapTypeName(data.front()));
+        } else {
+            fmt::format_to(fmt::appender(out), " std::tuple< {}", mapTypeName(data.front()));
+            for(const auto &j : data | std::views::drop(1)) { fmt::format_to(fmt::appender(out), " , {}", mapTypeName(j)); }
+            append(out, ">");
         }
-        return out.str();
     }
 
     // NOLINTBEGIN(*-convert-member-functions-to-static)
-    auto Transpiler::transpileKeyword(const Token &keyword) -> std::string {
+    auto Transpiler::transpileKeyword(const Token &keyword) -> std::string_view {
         using enum TokenType;
 
         switch(keyword.getType()) {
@@ -91,7 +308,7 @@ namespace vnd {
         case K_FOR:
             return "for(";
         case K_BREAK:
-            return std::string{keyword.getValue()};
+            return keyword.getValue();
         case K_FUN:
             return "auto ";
         case K_RETURN:
@@ -105,254 +322,225 @@ namespace vnd {
         }
     }
     // NOLINTEND(*-convert-member-functions-to-static)
-    DISABLE_WARNINGS_PUSH(26429)
-    std::string Transpiler::parseDeclaration(std::string input) {
-        std::ostringstream out;
-        std::array<std::vector<std::string>, 2> data;
-        uint8_t index = 0;
-        std::string currentToken;
-        const std::map<char, char> delimiters = {{'{', '}'}, {'(', ')'}, {'<', '>'}, {'[', ']'}, {'"', '"'}};
-        char currentDelimiter = '\0';
-        const size_t start = input.find_first_of(' ');
-        out << input.substr(0, start);
-        input = input.substr(start);
-        for(const auto i : input) {
-            if(i == ',' && currentDelimiter == '\0') {
-                data.at(index).emplace_back(currentToken);
-                currentToken.clear();
-            } else if(i == '=') {
-                data.at(index).emplace_back(currentToken);
-                currentToken.clear();
-                index++;
-            } else {
-                if(delimiters.contains(i) && currentDelimiter == '\0') {
-                    currentDelimiter = delimiters.at(i);
-                } else if(i == currentDelimiter) {
-                    currentDelimiter = '\0';
-                }
-                currentToken += i;
-            }
-        }
-        if(!currentToken.empty()) { data.at(index).emplace_back(currentToken); }
-        auto it = data.at(1).begin();
-        auto end = data.at(1).end();
-        bool first = true;
-        for(const auto &i : data.at(0)) {
-            if(!first) {
-                out << ",";
-            } else {
-                first = false;
+    // Main code generation function
+    void Transpiler::transpileNode(const FlatAST &ast, const NodeId node, OutputBuffer &out) {
+        // Code still to emit, the next item on top: the depth of the tree is bounded by memory, not by the call stack.
+        std::vector<PendingCode> pending{node};
+        // Scratch lists of the declarations met during the walk: their items are copied into pending at once.
+        std::vector<NodeId> declaredNames;
+        std::vector<NodeId> initializers;
+        while(!pending.empty()) {
+            const auto item = pending.back();
+            pending.pop_back();
+            if(item.node == noNode) {
+                append(out, item.text);
+                continue;
             }
-            out << i;
-            if(it != end) {
-                out << FORMAT(" ={}", *it);
-                ++it;
+            // Every helper emits its leading text at once and queues the rest in order; the queue is then reversed.
+            const auto queued = pending.size();
+            // Dispatch on the node kind and transpile code accordingly using helper functions
+            switch(ast.kind(item.node)) {
+                using enum NodeKind;
+            case BinaryExpression:
+                transpileBinaryExpressionNode(ast, item.node, pending);
+                break;
+            case UnaryExpression:
+                transpileUnaryExpressionNode(ast, item.node, out, pending);
+                break;
+            case Variable:
+                transpileVariableNode(ast, item.node, pending);
+                break;
+            case Integer:
+            case Float:
+            case Double:
+            case ImaginaryFloat:
+            case Imaginary:
+                transpileNumericNode(ast, item.node, out);
+                break;
+            case Boolean:
+            case Char:
+            case String:
+                transpileLiteralNode(ast, item.node, out);
+                break;
+            case Nullptr:
+                append(out, "nullptr");
+                break;
+            case Type:
+                transpileTypeNode(ast, item.node, out, pending);
+                break;
+            case Array:
+                transpileArrayNode(ast, item.node, pending);
+                break;
+            case Declaration:
+                transpileDeclarationNode(ast, item.node, pending, declaredNames, initializers);
+                break;
+            default:
+                LERROR("Unknown or not handled node type: {}", ast.token(item.node).getType());
+                break;
             }
+            std::reverse(pending.begin() + C_PTRDIFT(queued), pending.end());
         }
-        return out.str();
     }
-    DISABLE_WARNINGS_POP()
 
-    // Main code generation function
-    auto Transpiler::transpileNode(const ASTNode &node) -> std::string {
-        std::ostringstream code;
-        code.str().reserve(INITIAL_TOTAL_BUFFER_SIZE);
-
-        // Determine the type of node and transpile code accordingly using helper functions
-        if(const auto *binaryNode = node.safe_as<BinaryExpressionNode>()) {
-            code << transpileBinaryExpressionNode(binaryNode);
-        } else if(const auto *unaryNode = node.safe_as<UnaryExpressionNode>()) {
-            code << transpileUnaryExpressionNode(unaryNode);
-        } else if(const auto *variableNode = node.safe_as<VariableNode>()) {
-            code << transpileVariableNode(variableNode);
-        } else if(const auto *intnumberNode = node.safe_as<VND_NUM_INT>()) {
-            code << transpileNumericNode(intnumberNode);
-        } else if(const auto *cflnumberNode = node.safe_as<VND_NUM_CFLOAT>()) {
-            code << transpileNumericNode(cflnumberNode);
-        } else if(const auto *dflnumberNode = node.safe_as<VND_NUM_CDOUBLE>()) {
-            code << transpileNumericNode(dflnumberNode);
-        } else if(const auto *flnumberNode = node.safe_as<VND_NUM_FLOAT>()) {
-            code << transpileNumericNode(flnumberNode);
-        } else if(const auto *dblnumberNode = node.safe_as<VND_NUM_DOUBLE>()) {
-            code << transpileNumericNode(dblnumberNode);
-        } else if(const auto *blliteralNode = node.safe_as<LiteralNode<bool>>()) {
-            code << transpileLiteralNode(blliteralNode);
-        } else if(const auto *chliteralNode = node.safe_as<LiteralNode<char>>()) {
-            code << transpileLiteralNode(chliteralNode);
-        } else if(const auto *svliteralNode = node.safe_as<LiteralNode<std::string_view>>()) {
-            code << transpileLiteralNode(svliteralNode);
-        } else if([[maybe_unused]] const auto *nullptrNode = node.safe_as<NullptrNode>()) {
-            code << "nullptr";
-        } else if(const auto *typeNode = node.safe_as<TypeNode>()) {
-            code << transpileTypeNode(typeNode);
-        } else if(const auto *arrayNode = node.safe_as<ArrayNode>()) {
-            code << transpileArrayNode(arrayNode);
-        } else {
-            LERROR("Unknown or not handled node type: {}", node.getType());
-        }
-
-        return code.str();
-    }
-
-    DISABLE_WARNINGS_PUSH(26429)
-    void Transpiler::transpileBinaryExpressionNodeWhitFormat(const BinaryExpressionNode *binaryNode, std::ostringstream &code,
-                                                             const std::string &format) {
-        code << transpileNode(*binaryNode->getLeft());
-        code << format;
-        code << transpileNode(*binaryNode->getRight());
-    }
-    DISABLE_WARNINGS_POP()
-    // Helper function to transpile code for BinaryExpressionNode
-    auto Transpiler::transpileBinaryExpressionNode(const BinaryExpressionNode *binaryNode) -> std::string {
-        if(binaryNode == nullptr) { return ""; }
-        std::ostringstream code;
-        code.str().reserve(INITIAL_BUFFER_SIZE);
-        const auto op = binaryNode->getOp();
+    // Helper function to transpile code for binary expression nodes
+    void Transpiler::transpileBinaryExpressionNode(const FlatAST &ast, const NodeId binaryNode, std::vector<PendingCode> &pending) {
+        const auto op = ast.text(binaryNode);
+        const auto left = ast.child(binaryNode, NodeRole::Left);
+        const auto right = ast.child(binaryNode, NodeRole::Right);
         if(op == ":") {
-            const auto *binaryRight = binaryNode->getRight()->safe_as<BinaryExpressionNode>();
-            if(binaryRight != nullptr) [[likely]] {
-                code << transpileNode(*binaryRight->getLeft());
+            // A declaration names the type first: `a: i32 = 1` becomes `int32_t a = 1`.
+            if(ast.kind(right) == NodeKind::BinaryExpression) [[likely]] {
+                pending.insert(pending.end(), {ast.child(right, NodeRole::Left), " "sv, left, " "sv, ast.text(right), " "sv, ast.child(right, NodeRole::Right)});
             } else [[unlikely]] {
-                code << transpileNode(*binaryNode->getRight());
+                pending.insert(pending.end(), {right, " "sv, left});
             }
-            code << FORMAT(" {}", transpileNode(*binaryNode->getLeft()));
-            if(binaryRight != nullptr) [[likely]] {
-                code << FORMAT(" {} ", binaryRight->getOp());
-                code << transpileNode(*binaryRight->getRight());
-            }
-        } else if(op == ",") {
-            transpileBinaryExpressionNodeWhitFormat(binaryNode, code, FORMAT("{} ", op));
+            return;
+        }
+        if(op == ",") {
+            pending.insert(pending.end(), {left, ", "sv, right});
         } else {
-            transpileBinaryExpressionNodeWhitFormat(binaryNode, code, FORMAT(" {} ", op));
+            pending.insert(pending.end(), {left, " "sv, op, " "sv, right});
         }
-        return code.str();
     }
 
-    // Helper function to transpile code for UnaryExpressionNode
-    auto Transpiler::transpileUnaryExpressionNode(const UnaryExpressionNode *unaryNode) -> std::string {
-        if(unaryNode == nullptr) [[unlikely]] { return ""; }
-        return FORMAT("{}{}", unaryNode->getOp(), transpileNode(*unaryNode->getOperand()));
+    // Helper function to transpile code for unary expression nodes
+    void Transpiler::transpileUnaryExpressionNode(const FlatAST &ast, const NodeId unaryNode, OutputBuffer &out, std::vector<PendingCode> &pending) {
+        append(out, ast.text(unaryNode));
+        pending.emplace_back(ast.child(unaryNode, NodeRole::Operand));
     }
 
-    // Helper function to transpile code for VariableNode
-    auto Transpiler::transpileVariableNode(const VariableNode *variableNode) -> std::string {
-        if(variableNode == nullptr) [[unlikely]] { return ""; }
-        TranspileContext context;
-        if(const auto &indexNode = variableNode->get_index()) {
-            context.setIndexAndArray(transpileIndexNode(indexNode.get()));
-        } else {
-            context.index = "{}";
+    // Helper function to transpile code for variable nodes
+    void Transpiler::transpileVariableNode(const FlatAST &ast, const NodeId variableNode, std::vector<PendingCode> &pending) {
+        const auto indexNode = ast.child(variableNode, NodeRole::Index);
+        transpileIndexNode(ast, indexNode, ast.text(variableNode), pending);
+        transpileIndexArray(ast, indexNode, pending);
+        if(ast.isCall(variableNode)) {
+            pending.emplace_back("("sv);
+            if(const auto callNode = ast.child(variableNode, NodeRole::Call); callNode != noNode) { pending.emplace_back(callNode); }
+            pending.emplace_back(")"sv);
         }
-        context.code << fmt::vformat(context.index, fmt::make_format_args(variableNode->getName()));
-        if(!context.arr.empty()) { context.code << FORMAT("({})", context.arr); }
-        if(variableNode->is_call()) {
-            context.code << "(";
-            if(const auto &callNode = variableNode->get_call()) { context.code << transpileNode(*callNode); }
-            context.code << ")";
-        }
-        return context.code.str();
     }
 
-    // Helper function to transpile code for Numeric nodes
-    template <typename T> auto Transpiler::transpileNumericNode(const NumberNode<T> *numberNode) -> std::string {
-        if(numberNode == nullptr) [[unlikely]] { return ""; }
-        return FORMAT("{}", numberNode->get_value());
+    // Helper function to transpile code for number nodes
+    void Transpiler::transpileNumericNode(const FlatAST &ast, const NodeId numberNode, OutputBuffer &out) {
+        std::visit([&out](const auto &value) { fmt::format_to(fmt::appender(out), "{}", value); }, ast.number(numberNode));
     }
 
-    // Helper function to transpile code for LiteralNode
-    template <typename T> auto Transpiler::transpileLiteralNode(const LiteralNode<T> *literalNode) -> std::string {
-        if(literalNode == nullptr) [[unlikely]] { return ""; }
-        if constexpr(std::is_same_v<T, bool>) {
-            return literalNode->get_value() ? "true" : "false";
-        } else if constexpr(std::is_same_v<T, char>) {
-            return FORMAT("'{}'", literalNode->get_value());
-        } else if constexpr(std::is_same_v<T, std::string_view>) {
-            return FORMAT("\"{}\"", literalNode->get_value());
-        } else {
-            return "";
+    // Helper function to transpile code for literal nodes
+    void Transpiler::transpileLiteralNode(const FlatAST &ast, const NodeId literalNode, OutputBuffer &out) {
+        switch(ast.kind(literalNode)) {
+            using enum NodeKind;
+        case Boolean:
+            append(out, ast.boolean(literalNode) ? "true" : "false");
+            break;
+        case Char:
+            fmt::format_to(fmt::appender(out), "'{}'", ast.character(literalNode));
+            break;
+        case String:
+            fmt::format_to(fmt::appender(out), "\"{}\"", ast.text(literalNode));
+            break;
+        default:
+            break;
         }
     }
 
-    auto Transpiler::mapType(const std::string_view type) -> std::string {
-        static const std::unordered_map<std::string_view, std::string> typeMap = {
-            {"i8"sv, "int8_t"},
-            {"i16"sv, "int16_t"},
-            {"i32"sv, "int32_t"},
-            {"i64"sv, "int64_t"},
-            {"u8"sv, "uint8_t"},
-            {"u16"sv, "uint16_t"},
-            {"u32"sv, "uint32_t"},
-            {"u64"sv, "uint64_t"},
-            {"f32"sv, "float"},
-            {"f64"sv, "double"},
-            {"c32"sv, "std::complex<float>"},
-            {"c64"sv, "std::complex<double>"},
-            {"bool"sv, "bool"},
-            {"char"sv, "char"},
-            {"string"sv, "std::string_view"},
+    auto Transpiler::mapTypeName(const std::string_view type) -> std::string_view {
+        static const std::unordered_map<std::string_view, std::string_view> typeMap = {
+            {"i8"sv, "int8_t"sv},
+            {"i16"sv, "int16_t"sv},
+            {"i32"sv, "int32_t"sv},
+            {"i64"sv, "int64_t"sv},
+            {"u8"sv, "uint8_t"sv},
+            {"u16"sv, "uint16_t"sv},
+            {"u32"sv, "uint32_t"sv},
+            {"u64"sv, "uint64_t"sv},
+            {"f32"sv, "float"sv},
+            {"f64"sv, "double"sv},
+            {"c32"sv, "std::complex<float>"sv},
+            {"c64"sv, "std::complex<double>"sv},
+            {"bool"sv, "bool"sv},
+            {"char"sv, "char"sv},
+            {"string"sv, "std::string_view"sv},
         };
 
         if(const auto it = typeMap.find(type); it != typeMap.end()) { return it->second; }
-        return std::string(type);  // Default case to return a copy as a std::string
+        return type;  // Default case to return the type unchanged
     }
 
-    // Helper function to transpile code for TypeNode
-    auto Transpiler::transpileTypeNode(const TypeNode *typeNode) -> std::string {
-        if(typeNode == nullptr) [[unlikely]] { return ""; }
-        // code << typeNode.getName();
-        const auto initaltype = typeNode->get_value();
-        const auto mappedType = mapType(initaltype);
+    auto Transpiler::mapType(const std::string_view type) -> std::string { return std::string{mapTypeName(type)}; }
+
+    // Helper function to transpile code for type nodes
+    void Transpiler::transpileTypeNode(const FlatAST &ast, const NodeId typeNode, OutputBuffer &out, std::vector<PendingCode> &pending) {
+        const auto initaltype = ast.text(typeNode);
+        const auto mappedType = mapTypeName(initaltype);
         if(mappedType == "unknown"sv) [[unlikely]] {
-            return std::string(initaltype);
+            append(out, initaltype);
         } else [[likely]] {
-            TranspileContext context;
-            if(const auto &indexNode = typeNode->get_index()) {
-                context.setIndexAndArray(transpileIndexNode(indexNode.get()));
-            } else {
-                context.index = "{}";
-            }
-            context.code << fmt::vformat(context.index, fmt::make_format_args(mappedType));
-            if(!context.arr.empty()) { context.code << FORMAT("({})", context.arr); }
-            return context.code.str();
+            const auto indexNode = ast.child(typeNode, NodeRole::Index);
+            transpileIndexNode(ast, indexNode, mappedType, pending);
+            transpileIndexArray(ast, indexNode, pending);
         }
     }
 
-    // Helper function to transpile code for IndexNode
-    auto Transpiler::transpileIndexNode(const IndexNode *indexNode) -> std::pair<std::string, std::string> {
-        if(indexNode == nullptr) [[unlikely]] { return {}; }
-        std::string type;
-        TranspileContext context;
-        if(const auto &elementsIndexNode = indexNode->get_index()) {
-            context.setIndexAndArray(transpileIndexNode(elementsIndexNode.get()));
-        } else {
-            context.index = "{}";
+    // Helper function to transpile code for index nodes
+    void Transpiler::transpileIndexNode(const FlatAST &ast, const NodeId indexNode, const std::string_view name, std::vector<PendingCode> &pending) {
+        // `name[n][]` is an array of n vectors: the first index is the outermost container.
+        std::vector<NodeId> chain;
+        for(auto index = indexNode; index != noNode; index = ast.child(index, NodeRole::Index)) { chain.emplace_back(index); }
+        for(const auto index : chain) { pending.emplace_back(ast.child(index, NodeRole::Elements) != noNode ? "vnd::array<"sv : "vnd::vector<"sv); }
+        pending.emplace_back(name);
+        for(const auto index : chain | std::views::reverse) {
+            if(const auto elements = ast.child(index, NodeRole::Elements); elements != noNode) { pending.insert(pending.end(), {", "sv, elements}); }
+            pending.emplace_back(">"sv);
         }
-        if(const auto &elements = indexNode->get_elements()) {
-            type = FORMAT("vnd::array<{{}}, {}>", transpileNode(*elements));
+    }
+
+    void Transpiler::transpileIndexArray(const FlatAST &ast, const NodeId indexNode, std::vector<PendingCode> &pending) {
+        // The innermost index holding an array literal provides the constructor arguments.
+        NodeId arrayNode = noNode;
+        for(auto index = indexNode; index != noNode; index = ast.child(index, NodeRole::Index)) {
+            if(const auto array = ast.child(index, NodeRole::Array); array != noNode) { arrayNode = array; }
+        }
+        if(arrayNode == noNode) { return; }
+        pending.insert(pending.end(), {"("sv, arrayNode, ")"sv});
+    }
+
+    void Transpiler::collectList(const FlatAST &ast, const NodeId list, std::vector<NodeId> &items) {
+        items.clear();
+        // ',' associates to the left: the items after the first hang off the right of the left spine.
+        auto node = list;
+        for(; node != noNode && ast.kind(node) == NodeKind::BinaryExpression && ast.text(node) == ","; node = ast.child(node, NodeRole::Left)) {
+            items.emplace_back(ast.child(node, NodeRole::Right));
+        }
+        if(node != noNode) { items.emplace_back(node); }
+        std::ranges::reverse(items);
+    }
+
+    // Helper function to transpile code for declaration nodes
+    void Transpiler::transpileDeclarationNode(const FlatAST &ast, const NodeId declarationNode, std::vector<PendingCode> &pending,
+                                              std::vector<NodeId> &declaredNames, std::vector<NodeId> &initializers) {
+        if(const auto typeNode = ast.child(declarationNode, NodeRole::DeclaredType); typeNode != noNode) {
+            pending.emplace_back(typeNode);
         } else {
-            type = "vnd::vector<{}>";
+            pending.emplace_back("auto"sv);
         }
-        context.code << fmt::vformat(type, fmt::make_format_args(context.index));
-        if(!context.arr.empty()) { return std::make_pair(context.code.str(), context.arr); }
-        if(const auto &elementsArrayNode = indexNode->get_array()) {
-            return std::make_pair(context.code.str(), FORMAT("{}", transpileNode(*elementsArrayNode)));
+        collectList(ast, ast.child(declarationNode, NodeRole::Names), declaredNames);
+        collectList(ast, ast.child(declarationNode, NodeRole::Initializers), initializers);
+        for(std::size_t i = 0; i < declaredNames.size(); ++i) {
+            pending.insert(pending.end(), {i == 0 ? " "sv : ", "sv, declaredNames[i]});
+            if(i < initializers.size()) { pending.insert(pending.end(), {" = "sv, initializers[i]}); }
         }
-        return std::make_pair(context.code.str(), "");
     }
 
-    // Helper function to transpile code for ArrayNode
-    auto Transpiler::transpileArrayNode(const ArrayNode *arrayNode) -> std::string {
-        if(arrayNode == nullptr) [[unlikely]] { return ""; }
-        std::ostringstream code;
-        code.str().reserve(INITIAL_BUFFER_SIZE);
-        code << "{";
-        if(const auto &elementsNode = arrayNode->get_elements()) { code << transpileNode(*elementsNode); }
-        code << "}";
-        return code.str();
+    // Helper function to transpile code for array nodes
+    void Transpiler::transpileArrayNode(const FlatAST &ast, const NodeId arrayNode, std::vector<PendingCode> &pending) {
+        pending.emplace_back("{"sv);
+        if(const auto elementsNode = ast.child(arrayNode, NodeRole::Elements); elementsNode != noNode) { pending.emplace_back(elementsNode); }
+        pending.emplace_back("}"sv);
     }
 
 }  // namespace vnd
 
 // clang-format off
-// NOLINTEND(*-include-cleaner, *-easily-swappable-parameters, *-unused-variable, *-branch-clone, *-no-recursion, *-identifier-length)
+// NOLINTEND(*-include-cleaner, *-easily-swappable-parameters, *-unused-variable, *-branch-clone, *-identifier-length)
 // clang-format on
@@ -15,6 +15,13 @@ namespace vnd {
         timeParser(ast, parser);
         return ast;
     }
+
+    auto timeParse(CompilationUnit &unit) -> const std::vector<Statement> & {
+#ifdef INDEPT
+        const AutoTimer timer("parse");
+#endif
+        return unit.statements();
+    }
 }  // namespace vnd
 
 // NOLINTEND(*-include-cleaner)
\ No newline at end of file
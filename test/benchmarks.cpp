@@ -32,14 +32,69 @@ TEST_CASE("Tokenizer Benchmark", "[benchmark]") {
 
     vnd::Tokenizer tokenizer(input);
 
-    BENCHMARK("Tokenize sample input") { return tokenizer.tokenize(); };
+    // lex() reuses the token buffers of the previous run, so every iteration measures lexing alone.
+    BENCHMARK("Tokenize sample input") { return tokenizer.lex().tokenCount(); };
+    BENCHMARK("Reset and tokenize sample input") {
+        tokenizer.reset(input);
+        return tokenizer.lex().tokenCount();
+    };
 }
 
 TEST_CASE("Tokenizer Benchmark from file", "[benchmark]") {
     const std::string input = vnd::readFromFile(tfile.data());
     vnd::Tokenizer tokenizer(input);
 
-    BENCHMARK("Tokenize input file") { return tokenizer.tokenize(); };
+    BENCHMARK("Tokenize input file") { return tokenizer.lex().tokenCount(); };
 }
 
-// NOLINTEND(*-include-cleaner, *-avoid-magic-numbers, *-magic-numbers)
\ No newline at end of file
+TEST_CASE("Keyword lookup Benchmark", "[benchmark]") {
+    // Mix of keywords, types and plain identifiers as they appear in generated sources.
+    const std::vector<std::string_view> identifiers = {"var",    "num",   "i8",   "return", "funzione", "println", "string",
+                                                       "Derived", "while", "index", "f64",    "continue", "value",   "nullptr"};
+    // Linear scan used before the perfect hash, kept here as the baseline.
+    const auto linearLookup = [](const std::string_view value) {
+        auto type = vnd::TokenType::IDENTIFIER;
+        if(const auto it = std::ranges::find_if(vnd::keywordArray, [&value](const auto &pair) { return pair.first == value; });
+           it != vnd::keywordArray.end()) {
+            return it->second;
+        }
+        if(const auto it = std::ranges::find_if(vnd::typeArray, [&value](const auto &pair) { return pair.first == value; });
+           it != vnd::typeArray.end()) {
+            type = it->second;
+        }
+        return type;
+    };
+
+    BENCHMARK("Linear keyword lookup per identifier") {
+        std::size_t keywords = 0;
+        for(const auto &identifier : identifiers) { keywords += linearLookup(identifier) != vnd::TokenType::IDENTIFIER ? 1 : 0; }
+        return keywords;
+    };
+    BENCHMARK("Perfect hash keyword lookup per identifier") {
+        std::size_t keywords = 0;
+        for(const auto &identifier : identifiers) {
+            keywords += vnd::keywordTypeTable.find(identifier, vnd::TokenType::IDENTIFIER) != vnd::TokenType::IDENTIFIER ? 1 : 0;
+        }
+        return keywords;
+    };
+}
+
+TEST_CASE("Expression parser Benchmark on 100k-term expressions", "[benchmark]") {
+    constexpr std::size_t terms = 100000;
+    std::string chain = "x = a";
+    for(std::size_t term = 1; term < terms; ++term) { chain += term % 3 == 0 ? " * -b[1]" : " + f(c, 2)"; }
+    const auto nested = "x = " + std::string(terms, '(') + "a + b" + std::string(terms, ')');
+
+    // Arena nodes are not destroyed one by one, so tearing down the deep trees costs nothing between runs.
+    BENCHMARK("Parse a 100k-term operator chain") {
+        vnd::Arena arena;
+        vnd::Parser parser{chain, "chain.vn", arena};
+        return parser.parse().size();
+    };
+    BENCHMARK("Parse 100k nested parentheses") {
+        vnd::Arena arena;
+        vnd::Parser parser{nested, "nested.vn", arena};
+        return parser.parse().size();
+    };
+}
+// NOLINTEND(*-include-cleaner, *-avoid-magic-numbers, *-magic-numbers)
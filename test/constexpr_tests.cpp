@@ -85,4 +85,58 @@ TEST_CASE("singleCharOp function tests", "[singleCharOp]") {
     STATIC_REQUIRE(vnd::singoleCharOp('#') == vnd::TokenType::UNKNOWN);  // Unrecognized symbol
 }
 
+TEST_CASE("tokenizer character table classes", "[tokenizer]") {
+    using enum vnd::CharClass;
+    STATIC_REQUIRE(vnd::TokenizerUtility::getCharClass('a') == Alpha);
+    STATIC_REQUIRE(vnd::TokenizerUtility::getCharClass('Z') == Alpha);
+    STATIC_REQUIRE(vnd::TokenizerUtility::getCharClass('7') == Digit);
+    STATIC_REQUIRE(vnd::TokenizerUtility::getCharClass('_') == Underscore);
+    STATIC_REQUIRE(vnd::TokenizerUtility::getCharClass('#') == Hash);
+    STATIC_REQUIRE(vnd::TokenizerUtility::getCharClass('\r') == Space);
+    STATIC_REQUIRE(vnd::TokenizerUtility::getCharClass('/') == Slash);
+    STATIC_REQUIRE(vnd::TokenizerUtility::getCharClass('%') == Operator);
+    STATIC_REQUIRE(vnd::TokenizerUtility::getCharClass('.') == Dot);
+    STATIC_REQUIRE(vnd::TokenizerUtility::getCharClass('}') == Bracket);
+    STATIC_REQUIRE(vnd::TokenizerUtility::getCharClass('\'') == Apostrophe);
+    STATIC_REQUIRE(vnd::TokenizerUtility::getCharClass('"') == Quotation);
+    STATIC_REQUIRE(vnd::TokenizerUtility::getCharClass(':') == CommaColon);
+    STATIC_REQUIRE(vnd::TokenizerUtility::getCharClass(';') == Unknown);
+    STATIC_REQUIRE(vnd::TokenizerUtility::getCharClass(static_cast<char>(0xE0)) == Unknown);
+}
+
+TEST_CASE("tokenizer character table traits", "[tokenizer]") {
+    STATIC_REQUIRE(vnd::TokenizerUtility::hasTrait('_', vnd::TRAIT_IDENT));
+    STATIC_REQUIRE(vnd::TokenizerUtility::hasTrait('9', vnd::TRAIT_IDENT));
+    STATIC_REQUIRE_FALSE(vnd::TokenizerUtility::hasTrait('-', vnd::TRAIT_IDENT));
+    STATIC_REQUIRE(vnd::TokenizerUtility::hasTrait('F', vnd::TRAIT_HEX));
+    STATIC_REQUIRE_FALSE(vnd::TokenizerUtility::hasTrait('g', vnd::TRAIT_HEX));
+    STATIC_REQUIRE(vnd::TokenizerUtility::hasTrait('7', vnd::TRAIT_OCTAL));
+    STATIC_REQUIRE_FALSE(vnd::TokenizerUtility::hasTrait('8', vnd::TRAIT_OCTAL));
+    STATIC_REQUIRE(vnd::TokenizerUtility::hasTrait('/', vnd::TRAIT_OPERATOR));
+    STATIC_REQUIRE(vnd::TokenizerUtility::hasTrait('\n', vnd::TRAIT_NEWLINE));
+    STATIC_REQUIRE_FALSE(vnd::TokenizerUtility::hasTrait('\t', vnd::TRAIT_NEWLINE));
+}
+
+TEST_CASE("compact token layout", "[token]") {
+    STATIC_REQUIRE(sizeof(vnd::Token) == 16);
+    STATIC_REQUIRE(std::is_trivially_copyable_v<vnd::Token>);
+}
+
+TEST_CASE("keyword and type perfect hash", "[tokenizer]") {
+    using enum vnd::TokenType;
+    STATIC_REQUIRE(std::ranges::all_of(vnd::keywordArray, [](const auto &pair) { return vnd::keywordTypeTable.find(pair.first, UNKNOWN) == pair.second; }));
+    STATIC_REQUIRE(std::ranges::all_of(vnd::typeArray, [](const auto &pair) { return vnd::keywordTypeTable.find(pair.first, UNKNOWN) == pair.second; }));
+    STATIC_REQUIRE(vnd::keywordTypeTable.find("whale", IDENTIFIER) == IDENTIFIER);
+    STATIC_REQUIRE(vnd::keywordTypeTable.find("i128", IDENTIFIER) == IDENTIFIER);
+    STATIC_REQUIRE(vnd::keywordTypeTable.find("", IDENTIFIER) == IDENTIFIER);
+}
+
+TEST_CASE("multi char operator perfect hash", "[tokenizer]") {
+    using enum vnd::TokenType;
+    STATIC_REQUIRE(std::ranges::all_of(vnd::multiCharOperators,
+                                       [](const auto &pair) { return vnd::multiCharOperatorTable.find(pair.first, UNKNOWN) == pair.second; }));
+    STATIC_REQUIRE(vnd::multiCharOperatorTable.find("=+", UNKNOWN) == UNKNOWN);
+    STATIC_REQUIRE(vnd::multiCharOperatorTable.find("**", UNKNOWN) == UNKNOWN);
+}
+
 // NOLINTEND(*-err58-cpp, *-include-cleaner, *-use-anonymous-namespace, *-function-cognitive-complexity, *-avoid-do-while)
\ No newline at end of file
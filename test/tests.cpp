@@ -7,7 +7,11 @@
 #include <catch2/matchers/catch_matchers_container_properties.hpp>
 #include <catch2/matchers/catch_matchers_exception.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
 #include <future>
+#include <new>
 
 #include "testsConstanst.hpp"
 
@@ -25,6 +29,71 @@ using Catch::Matchers::StartsWith;
 #define REQ_FORMAT_COMPTOK(type, string) REQUIRE(FORMAT("{}", comp_tokType(type)) == (string));
 #define MSG_FORMAT(...) Message(FORMAT(__VA_ARGS__))
 
+// Counts the allocations made by the test binary, to check code paths that must not allocate. Every replaceable
+// operator new and delete is replaced, so no form falls back to the library pair; GCC still pairs the inlined
+// operator new with the free() of operator delete and warns, so the warning is silenced for these definitions only.
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+namespace {
+    std::atomic<std::size_t> allocationCount{0};
+
+    void *countedAllocate(const std::size_t size) noexcept {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    // Over-aligned blocks keep the pointer malloc() returned right before the aligned address.
+    void *countedAllocate(const std::size_t size, const std::align_val_t alignment) noexcept {
+        const auto align = static_cast<std::size_t>(alignment);
+        void *memory = countedAllocate(size + align + sizeof(void *));
+        if(memory == nullptr) { return nullptr; }
+        const auto address = (reinterpret_cast<std::uintptr_t>(memory) + sizeof(void *) + align - 1) & ~(align - 1);
+        auto *aligned = reinterpret_cast<void *>(address);
+        std::memcpy(static_cast<std::byte *>(aligned) - sizeof(void *), static_cast<const void *>(&memory), sizeof(void *));
+        return aligned;
+    }
+
+    void countedFree(void *memory) noexcept { std::free(memory); }
+
+    void countedFree(void *memory, std::align_val_t) noexcept {
+        if(memory == nullptr) { return; }
+        void *original = nullptr;
+        std::memcpy(static_cast<void *>(&original), static_cast<const std::byte *>(memory) - sizeof(void *), sizeof(void *));
+        std::free(original);
+    }
+
+    template <typename... Alignment> void *countedAllocateOrThrow(const std::size_t size, const Alignment... alignment) {
+        if(void *memory = countedAllocate(size, alignment...)) { return memory; }
+        throw std::bad_alloc{};
+    }
+}  // namespace
+
+void *operator new(std::size_t size) { return countedAllocateOrThrow(size); }
+void *operator new[](std::size_t size) { return countedAllocateOrThrow(size); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return countedAllocate(size); }
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return countedAllocate(size); }
+void *operator new(std::size_t size, std::align_val_t alignment) { return countedAllocateOrThrow(size, alignment); }
+void *operator new[](std::size_t size, std::align_val_t alignment) { return countedAllocateOrThrow(size, alignment); }
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept { return countedAllocate(size, alignment); }
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept { return countedAllocate(size, alignment); }
+void operator delete(void *memory) noexcept { countedFree(memory); }
+void operator delete[](void *memory) noexcept { countedFree(memory); }
+void operator delete(void *memory, std::size_t) noexcept { countedFree(memory); }
+void operator delete[](void *memory, std::size_t) noexcept { countedFree(memory); }
+void operator delete(void *memory, const std::nothrow_t &) noexcept { countedFree(memory); }
+void operator delete[](void *memory, const std::nothrow_t &) noexcept { countedFree(memory); }
+void operator delete(void *memory, std::align_val_t alignment) noexcept { countedFree(memory, alignment); }
+void operator delete[](void *memory, std::align_val_t alignment) noexcept { countedFree(memory, alignment); }
+void operator delete(void *memory, std::size_t, std::align_val_t alignment) noexcept { countedFree(memory, alignment); }
+void operator delete[](void *memory, std::size_t, std::align_val_t alignment) noexcept { countedFree(memory, alignment); }
+void operator delete(void *memory, std::align_val_t alignment, const std::nothrow_t &) noexcept { countedFree(memory, alignment); }
+void operator delete[](void *memory, std::align_val_t alignment, const std::nothrow_t &) noexcept { countedFree(memory, alignment); }
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+#pragma GCC diagnostic pop
+#endif
+
 TEST_CASE("Logger setup", "[setup_logger]") {
     SECTION("Default setup") { REQUIRE_NOTHROW(setup_logger()); }
     SECTION("Logger sinks") {
@@ -348,6 +417,30 @@ TEST_CASE("createFile: Attempt to create a file with empty content", "[FileCreat
     fs::remove_all(testDir);
 }
 
+TEST_CASE("createFile: Leave a file that already holds the content untouched", "[FileCreationResult]") {
+    const fs::path testDir = fs::temp_directory_path() / "test_file_unchanged";
+    fs::create_directories(testDir);
+    const std::string fileName = "unchanged_file.txt";
+    const fs::path filePath = testDir / fileName;
+
+    REQUIRE(vnd::FileCreationResult::createFile(testDir, fileName, "Same content."sv).success());
+    const auto past = fs::last_write_time(filePath) - std::chrono::hours(1);
+    fs::last_write_time(filePath, past);
+
+    REQUIRE(vnd::FileCreationResult::createFile(testDir, fileName, "Same content."sv).success());
+    REQUIRE(fs::last_write_time(filePath) == past);
+
+    // Same size, different bytes.
+    REQUIRE(vnd::FileCreationResult::createFile(testDir, fileName, "Same CONTENT."sv).success());
+    REQUIRE(fs::last_write_time(filePath) != past);
+    REQUIRE(vnd::readFromFile(filePath.string()) == "Same CONTENT.");
+    // The temporary file was renamed over the file: nothing else is left in the folder.
+    REQUIRE(std::distance(fs::directory_iterator(testDir), fs::directory_iterator{}) == 1);
+
+    // Cleanup
+    fs::remove_all(testDir);
+}
+
 static fs::path createTestFolderStructure() {
     fs::path testFolder = fs::temp_directory_path() / "test_folder_deletion";
     if(fs::exists(testFolder)) { fs::remove_all(testFolder); }
@@ -502,6 +595,111 @@ TEST_CASE("deleteFolder: Handle exceptions gracefully", "[FolderDeletionResult]"
     REQUIRE_FALSE(result.success());
 }
 
+TEST_CASE("Arena: aligned bump allocation and chunk growth", "[Arena]") {
+    vnd::Arena arena{256};
+    REQUIRE(arena.chunkCount() == 0);
+    const auto *first = static_cast<std::byte *>(arena.allocate(3, 1));
+    const auto *second = static_cast<std::byte *>(arena.allocate(8, 8));
+    REQUIRE(arena.chunkCount() == 1);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(second) % 8 == 0);
+    REQUIRE(second - first == 8);
+    REQUIRE(arena.bytesUsed() == 16);
+    const auto *aligned = arena.allocate(1, 64);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(aligned) % 64 == 0);
+    for(int i = 0; i < 100; ++i) { std::ignore = arena.allocate(16); }
+    REQUIRE(arena.chunkCount() > 1);
+    std::ignore = arena.allocate(100'000);
+    const auto chunks = arena.chunkCount();
+
+    arena.reset();
+    REQUIRE(arena.chunkCount() == 1);
+    REQUIRE(arena.bytesUsed() == 0);
+    const auto before = allocationCount.load();
+    for(int i = 0; i < 1000; ++i) { std::ignore = arena.allocate(64); }
+    REQUIRE(allocationCount.load() == before);
+    arena.release();
+    REQUIRE(arena.chunkCount() == 0);
+    REQUIRE(chunks > 2);
+}
+
+TEST_CASE("Arena: create runs destructors on reset only when needed", "[Arena]") {
+    vnd::Arena arena;
+    std::vector<int> destroyed;
+    struct Tracked {
+        std::vector<int> *log;
+        int id;
+        Tracked(std::vector<int> *log_, int id_) noexcept : log(log_), id(id_) {}
+        Tracked(const Tracked &other) = delete;
+        Tracked &operator=(const Tracked &other) = delete;
+        ~Tracked() { log->push_back(id); }
+    };
+    const auto *trivial = arena.create<std::pair<int, double>>(1, 2.5);
+    REQUIRE(trivial->second == 2.5);
+    for(int i = 0; i < 3; ++i) { REQUIRE(arena.create<Tracked>(&destroyed, i)->id == i); }
+    auto *text = arena.create<std::string>(50, 'x');
+    REQUIRE(text->size() == 50);
+    arena.reset();
+    REQUIRE(destroyed == std::vector<int>{2, 1, 0});
+    arena.release();
+    REQUIRE(destroyed.size() == 3);
+}
+
+TEST_CASE("Arena: pmr resource and allocator adapters", "[Arena]") {
+    vnd::Arena arena{1024};
+    vnd::ArenaResource resource{arena};
+    std::pmr::vector<int> numbers{&resource};
+    for(int i = 0; i < 100; ++i) { numbers.push_back(i); }
+    REQUIRE(numbers.back() == 99);
+    REQUIRE(arena.bytesUsed() >= 100 * sizeof(int));
+    REQUIRE(resource.is_equal(resource));
+    vnd::ArenaResource other{arena};
+    REQUIRE_FALSE(resource.is_equal(other));
+
+    std::vector<double, vnd::ArenaAllocator<double>> values{vnd::ArenaAllocator<double>{arena}};
+    values.assign(10, 1.5);
+    REQUIRE(values.get_allocator() == vnd::ArenaAllocator<int>{arena});
+    REQUIRE(&values.get_allocator().arena() == &arena);
+}
+
+TEST_CASE("Arena: absorb takes over the chunks and objects of another arena", "[Arena]") {
+    std::vector<int> destroyed;
+    struct Tracked {
+        std::vector<int> *log;
+        int id;
+        Tracked(std::vector<int> *log_, int id_) noexcept : log(log_), id(id_) {}
+        Tracked(const Tracked &other) = delete;
+        Tracked &operator=(const Tracked &other) = delete;
+        ~Tracked() { log->push_back(id); }
+    };
+    vnd::Arena target{256};
+    vnd::Arena empty;
+    empty.absorb(vnd::Arena{});
+    REQUIRE(empty.chunkCount() == 0);
+    std::ignore = target.create<Tracked>(&destroyed, 0);
+    vnd::Arena source{256};
+    auto *kept = static_cast<int *>(source.allocate(sizeof(int), alignof(int)));
+    *kept = 42;
+    std::ignore = source.create<Tracked>(&destroyed, 1);
+    for(int i = 0; i < 40; ++i) { std::ignore = source.allocate(16); }
+    const auto used = target.bytesUsed() + source.bytesUsed();
+    const auto chunks = target.chunkCount() + source.chunkCount();
+    const auto *next = static_cast<std::byte *>(target.allocate(1, 1));
+    target.absorb(std::move(source));
+    REQUIRE(source.chunkCount() == 0);
+    REQUIRE(source.bytesUsed() == 0);
+    REQUIRE(target.chunkCount() == chunks);
+    REQUIRE(target.bytesUsed() == used + 1);
+    REQUIRE(static_cast<std::byte *>(target.allocate(1, 1)) == next + 1);
+    REQUIRE(*kept == 42);
+    source.release();
+    REQUIRE(destroyed.empty());
+
+    empty.absorb(std::move(target));
+    REQUIRE(empty.chunkCount() == chunks);
+    empty.release();
+    REQUIRE(destroyed == std::vector<int>{1, 0});
+}
+
 TEST_CASE("singleCharOp function tests", "[singleCharOp]") {
     // Test valid operators
     REQUIRE(vnd::singoleCharOp('-') == vnd::TokenType::MINUS);
@@ -1214,9 +1412,9 @@ TEST_CASE("TokenizerUtility CommaOrColonValue", "[tokenizer]") {
 
 TEST_CASE("tokenizer emit identifier token", "[tokenizer]") {
     vnd::Tokenizer tokenizer{"a a_ a0 a000_ _a", filename};
-    std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+    vnd::TokenStream result = tokenizer.tokenize();
     REQUIRE(result.size() == 1);
-    vnd::TokenVec tokens = result.front();
+    vnd::TokenSpan tokens = result.front();
     REQUIRE(tokens.size() == 6);
     REQUIRE(tokens[0] == vnd::Token(identf, "a", vnd::CodeSourceLocation(filename, 1, 1)));
     REQUIRE(tokens[1] == vnd::Token(identf, "a_", vnd::CodeSourceLocation(filename, 1, 3)));
@@ -1227,9 +1425,9 @@ TEST_CASE("tokenizer emit identifier token", "[tokenizer]") {
 
 TEST_CASE("tokenizer emit identifier token new line", "[tokenizer]") {
     vnd::Tokenizer tokenizer{"a a_\na0 a000_ _a", filename};
-    std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+    vnd::TokenStream result = tokenizer.tokenize();
     REQUIRE(result.size() == 2);
-    vnd::TokenVec tokens = result.at(0);
+    vnd::TokenSpan tokens = result.at(0);
     REQUIRE(tokens.size() == 2);
     REQUIRE(tokens[0] == vnd::Token(identf, "a", vnd::CodeSourceLocation(filename, 1, 1)));
     REQUIRE(tokens[1] == vnd::Token(identf, "a_", vnd::CodeSourceLocation(filename, 1, 3)));
@@ -1244,15 +1442,15 @@ TEST_CASE("tokenizer emit identifier token new line", "[tokenizer]") {
 TEST_CASE("tokenizer emit integer token for hexadecimals numbers", "[tokenizer]") {
     // hexadecimals 0xhexnum a-f A-F 0-9
     vnd::Tokenizer tokenizer{"#0 #23 #24 #ff #7f", filename};
-    std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+    vnd::TokenStream result = tokenizer.tokenize();
     REQUIRE(result.size() == 1);
-    vnd::TokenVec tokens = result.front();
+    vnd::TokenSpan tokens = result.front();
     REQUIRE(tokens.size() == 6);
-    REQUIRE(tokens[0] == vnd::Token(inte, "#0", vnd::CodeSourceLocation(filename, 1, 0)));
-    REQUIRE(tokens[1] == vnd::Token(inte, "#23", vnd::CodeSourceLocation(filename, 1, 3)));
-    REQUIRE(tokens[2] == vnd::Token(inte, "#24", vnd::CodeSourceLocation(filename, 1, t_colum3)));
-    REQUIRE(tokens[3] == vnd::Token(inte, "#ff", vnd::CodeSourceLocation(filename, 1, t_colum8)));
-    REQUIRE(tokens[4] == vnd::Token(inte, "#7f", vnd::CodeSourceLocation(filename, 1, t_colum10)));
+    REQUIRE(tokens[0] == vnd::Token(inte, "#0", vnd::CodeSourceLocation(filename, 1, 1)));
+    REQUIRE(tokens[1] == vnd::Token(inte, "#23", vnd::CodeSourceLocation(filename, 1, 4)));
+    REQUIRE(tokens[2] == vnd::Token(inte, "#24", vnd::CodeSourceLocation(filename, 1, 8)));
+    REQUIRE(tokens[3] == vnd::Token(inte, "#ff", vnd::CodeSourceLocation(filename, 1, 12)));
+    REQUIRE(tokens[4] == vnd::Token(inte, "#7f", vnd::CodeSourceLocation(filename, 1, 16)));
 }
 
 TEST_CASE("tokenizer emit exception on  malformed exadecimal number or octal number", "[tokenizer]") {
@@ -1264,20 +1462,20 @@ TEST_CASE("tokenizer emit exception on  malformed exadecimal number or octal num
 TEST_CASE("tokenizer emit integer token for octal numbers", "[tokenizer]") {
     // octal 0oOctnum 0-7
     vnd::Tokenizer tokenizer{"#o0 #o23 #o24", filename};
-    std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+    vnd::TokenStream result = tokenizer.tokenize();
     REQUIRE(result.size() == 1);
-    vnd::TokenVec tokens = result.front();
+    vnd::TokenSpan tokens = result.front();
     REQUIRE(tokens.size() == 4);
-    REQUIRE(tokens[0] == vnd::Token(inte, "#o0", vnd::CodeSourceLocation(filename, 1, 0)));
-    REQUIRE(tokens[1] == vnd::Token(inte, "#o23", vnd::CodeSourceLocation(filename, 1, 4)));
-    REQUIRE(tokens[2] == vnd::Token(inte, "#o24", vnd::CodeSourceLocation(filename, 1, t_colum5)));
+    REQUIRE(tokens[0] == vnd::Token(inte, "#o0", vnd::CodeSourceLocation(filename, 1, 1)));
+    REQUIRE(tokens[1] == vnd::Token(inte, "#o23", vnd::CodeSourceLocation(filename, 1, 5)));
+    REQUIRE(tokens[2] == vnd::Token(inte, "#o24", vnd::CodeSourceLocation(filename, 1, 10)));
 }
 
 TEST_CASE("tokenizer emit integer token", "[tokenizer]") {
     vnd::Tokenizer tokenizer{"42 333 550 34000000", filename};
-    std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+    vnd::TokenStream result = tokenizer.tokenize();
     REQUIRE(result.size() == 1);
-    vnd::TokenVec tokens = result.front();
+    vnd::TokenSpan tokens = result.front();
     REQUIRE(tokens.size() == 5);
     REQUIRE(tokens[0] == vnd::Token(inte, "42", vnd::CodeSourceLocation(filename, 1, 1)));
     REQUIRE(tokens[1] == vnd::Token(inte, "333", vnd::CodeSourceLocation(filename, 1, 4)));
@@ -1287,9 +1485,9 @@ TEST_CASE("tokenizer emit integer token", "[tokenizer]") {
 
 TEST_CASE("tokenizer emit integer token new line", "[tokenizer]") {
     vnd::Tokenizer tokenizer{"42 333\n550 34000000", filename};
-    std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+    vnd::TokenStream result = tokenizer.tokenize();
     REQUIRE(result.size() == 2);
-    vnd::TokenVec tokens = result.at(0);
+    vnd::TokenSpan tokens = result.at(0);
     REQUIRE(tokens.size() == 2);
     REQUIRE(tokens[0] == vnd::Token(inte, "42", vnd::CodeSourceLocation(filename, 1, 1)));
     REQUIRE(tokens[1] == vnd::Token(inte, "333", vnd::CodeSourceLocation(filename, 1, 4)));
@@ -1302,9 +1500,9 @@ TEST_CASE("tokenizer emit integer token new line", "[tokenizer]") {
 
 TEST_CASE("tokenizer emit double token", "[tokenizer]") {
     vnd::Tokenizer tokenizer{"1. 1.0 1e+1 1E+1 1.1e+1 1.1E+1 1e-1 1E-1 1.1e-1 1.1E-1 .4e12 4i 5.4if .7f", filename};
-    std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+    vnd::TokenStream result = tokenizer.tokenize();
     REQUIRE(result.size() == 1);
-    vnd::TokenVec tokens = result.front();
+    vnd::TokenSpan tokens = result.front();
     REQUIRE(tokens.size() == 15);
     REQUIRE(tokens[0] == vnd::Token(doub, "1.", vnd::CodeSourceLocation(filename, 1, 1)));
     REQUIRE(tokens[1] == vnd::Token(doub, "1.0", vnd::CodeSourceLocation(filename, 1, 4)));
@@ -1325,9 +1523,9 @@ TEST_CASE("tokenizer emit double token", "[tokenizer]") {
 TEST_CASE("tokenizer emit operator token", "[tokenizer]") {
     using enum vnd::TokenType;
     vnd::Tokenizer tokenizer{"* / = , : < > ! | & + - ^ . %", filename};
-    std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+    vnd::TokenStream result = tokenizer.tokenize();
     REQUIRE(result.size() == 1);
-    vnd::TokenVec tokens = result.front();
+    vnd::TokenSpan tokens = result.front();
     REQUIRE(tokens.size() == 16);
     REQUIRE(tokens[0] == vnd::Token(STAR, "*", vnd::CodeSourceLocation(filename, 1, 1)));
     REQUIRE(tokens[1] == vnd::Token(DIVIDE, "/", vnd::CodeSourceLocation(filename, 1, 3)));
@@ -1350,9 +1548,9 @@ TEST_CASE("tokenizer emit operator token", "[tokenizer]") {
 TEST_CASE("tokenizer emit operationEqual token", "[tokenizer]") {
     using enum vnd::TokenType;
     vnd::Tokenizer tokenizer{"+= -= *= /= %=", filename};
-    std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+    vnd::TokenStream result = tokenizer.tokenize();
     REQUIRE(result.size() == 1);
-    vnd::TokenVec tokens = result.front();
+    vnd::TokenSpan tokens = result.front();
     REQUIRE(tokens.size() == 6);
     REQUIRE(tokens[0] == vnd::Token(PLUSEQUAL, "+=", vnd::CodeSourceLocation(filename, 1, 1)));
     REQUIRE(tokens[1] == vnd::Token(MINUSEQUAL, "-=", vnd::CodeSourceLocation(filename, 1, 4)));
@@ -1364,9 +1562,9 @@ TEST_CASE("tokenizer emit operationEqual token", "[tokenizer]") {
 TEST_CASE("tokenizer emit boolean operator token", "[tokenizer]") {
     using enum vnd::TokenType;
     vnd::Tokenizer tokenizer{"== >= <= !=", filename};
-    std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+    vnd::TokenStream result = tokenizer.tokenize();
     REQUIRE(result.size() == 1);
-    vnd::TokenVec tokens = result.front();
+    vnd::TokenSpan tokens = result.front();
     REQUIRE(tokens.size() == 5);
     REQUIRE(tokens[0] == vnd::Token(EQUALEQUAL, "==", vnd::CodeSourceLocation(filename, 1, 1)));
     REQUIRE(tokens[1] == vnd::Token(GREATEREQUAL, ">=", vnd::CodeSourceLocation(filename, 1, 4)));
@@ -1376,9 +1574,9 @@ TEST_CASE("tokenizer emit boolean operator token", "[tokenizer]") {
 
 TEST_CASE("tokenizer emit logical operator token", "[tokenizer]") {
     vnd::Tokenizer tokenizer{"&& ||", filename};
-    std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+    vnd::TokenStream result = tokenizer.tokenize();
     REQUIRE(result.size() == 1);
-    vnd::TokenVec tokens = result.front();
+    vnd::TokenSpan tokens = result.front();
     REQUIRE(tokens.size() == 3);
     REQUIRE(tokens[0] == vnd::Token(vnd::TokenType::ANDAND, "&&", vnd::CodeSourceLocation(filename, 1, 1)));
     REQUIRE(tokens[1] == vnd::Token(vnd::TokenType::OROR, "||", vnd::CodeSourceLocation(filename, 1, 4)));
@@ -1386,9 +1584,9 @@ TEST_CASE("tokenizer emit logical operator token", "[tokenizer]") {
 
 TEST_CASE("tokenizer emit unary operator token", "[tokenizer]") {
     vnd::Tokenizer tokenizer{"++ --", filename};
-    std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+    vnd::TokenStream result = tokenizer.tokenize();
     REQUIRE(result.size() == 1);
-    vnd::TokenVec tokens = result.front();
+    vnd::TokenSpan tokens = result.front();
     REQUIRE(tokens.size() == 3);
     REQUIRE(tokens[0] == vnd::Token(vnd::TokenType::PLUSPLUS, "++", vnd::CodeSourceLocation(filename, 1, 1)));
     REQUIRE(tokens[1] == vnd::Token(vnd::TokenType::MINUSMINUS, "--", vnd::CodeSourceLocation(filename, 1, 4)));
@@ -1396,9 +1594,9 @@ TEST_CASE("tokenizer emit unary operator token", "[tokenizer]") {
 
 TEST_CASE("tokenizer emit parenthesis token", "[tokenizer]") {
     vnd::Tokenizer tokenizer{"( )", filename};
-    std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+    vnd::TokenStream result = tokenizer.tokenize();
     REQUIRE(result.size() == 1);
-    vnd::TokenVec tokens = result.front();
+    vnd::TokenSpan tokens = result.front();
     REQUIRE(tokens.size() == 3);
     REQUIRE(tokens[0] == vnd::Token(vnd::TokenType::OPEN_PARENTESIS, "(", vnd::CodeSourceLocation(filename, 1, 1)));
     REQUIRE(tokens[1] == vnd::Token(vnd::TokenType::CLOSE_PARENTESIS, ")", vnd::CodeSourceLocation(filename, 1, 3)));
@@ -1406,9 +1604,9 @@ TEST_CASE("tokenizer emit parenthesis token", "[tokenizer]") {
 
 TEST_CASE("tokenizer emit square parenthesis token", "[tokenizer]") {
     vnd::Tokenizer tokenizer{"[ ]", filename};
-    std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+    vnd::TokenStream result = tokenizer.tokenize();
     REQUIRE(result.size() == 1);
-    vnd::TokenVec tokens = result.front();
+    vnd::TokenSpan tokens = result.front();
     REQUIRE(tokens.size() == 3);
     REQUIRE(tokens[0] == vnd::Token(vnd::TokenType::OPEN_SQ_PARENTESIS, "[", vnd::CodeSourceLocation(filename, 1, 1)));
     REQUIRE(tokens[1] == vnd::Token(vnd::TokenType::CLOSE_SQ_PARENTESIS, "]", vnd::CodeSourceLocation(filename, 1, 3)));
@@ -1416,9 +1614,9 @@ TEST_CASE("tokenizer emit square parenthesis token", "[tokenizer]") {
 
 TEST_CASE("Tokenizer emit square curly token", "[Tokenizer]") {
     vnd::Tokenizer tokenizer{"{ }", filename};
-    std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+    vnd::TokenStream result = tokenizer.tokenize();
     REQUIRE(result.size() == 1);
-    vnd::TokenVec tokens = result.front();
+    vnd::TokenSpan tokens = result.front();
     REQUIRE(tokens.size() == 3);
     REQUIRE(tokens[0] == vnd::Token(vnd::TokenType::OPEN_CUR_PARENTESIS, "{", vnd::CodeSourceLocation(filename, 1, 1)));
     REQUIRE(tokens[1] == vnd::Token(vnd::TokenType::CLOSE_CUR_PARENTESIS, "}", vnd::CodeSourceLocation(filename, 1, 3)));
@@ -1428,9 +1626,9 @@ TEST_CASE("Tokenizer emit char token", "[Tokenizer]") {
     using enum vnd::TokenType;
     constexpr std::string_view code2 = R"('a' '\\' '')";
     vnd::Tokenizer tokenizer{code2, filename};
-    std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+    vnd::TokenStream result = tokenizer.tokenize();
     REQUIRE(result.size() == 1);
-    vnd::TokenVec tokens = result.front();
+    vnd::TokenSpan tokens = result.front();
     REQUIRE(tokens.size() == 4);
     REQUIRE(tokens[0] == vnd::Token(CHAR, "a", vnd::CodeSourceLocation(filename, 1, 2)));
     REQUIRE(tokens[1] == vnd::Token(CHAR, R"(\\)", vnd::CodeSourceLocation(filename, 1, t_colum)));
@@ -1447,21 +1645,21 @@ TEST_CASE("Tokenizer emit string token", "[Tokenizer]") {
     using enum vnd::TokenType;
     constexpr std::string_view code2 = R"("a" "\\" "")";
     vnd::Tokenizer tokenizer{code2, filename};
-    std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+    vnd::TokenStream result = tokenizer.tokenize();
     REQUIRE(result.size() == 1);
-    vnd::TokenVec tokens = result.front();
+    vnd::TokenSpan tokens = result.front();
     REQUIRE(tokens.size() == 4);
-    REQUIRE(tokens[0] == vnd::Token(STRING, "a", vnd::CodeSourceLocation(filename, 1, 1)));
-    REQUIRE(tokens[1] == vnd::Token(STRING, R"(\\)", vnd::CodeSourceLocation(filename, 1, 5)));
-    REQUIRE(tokens[2] == vnd::Token(STRING, "", vnd::CodeSourceLocation(filename, 1, 10)));
+    REQUIRE(tokens[0] == vnd::Token(STRING, "a", vnd::CodeSourceLocation(filename, 1, 2)));
+    REQUIRE(tokens[1] == vnd::Token(STRING, R"(\\)", vnd::CodeSourceLocation(filename, 1, 6)));
+    REQUIRE(tokens[2] == vnd::Token(STRING, "", vnd::CodeSourceLocation(filename, 1, 11)));
 }
 
 TEST_CASE("tokenizer emit unknown token on non closed char token", "[tokenizer]") {
     constexpr std::string_view code2 = R"('a")";
     vnd::Tokenizer tokenizer{code2, filename};
-    const std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+    const vnd::TokenStream result = tokenizer.tokenize();
     REQUIRE(result.size() == 1);
-    const vnd::TokenVec tokens = result.front();
+    const vnd::TokenSpan tokens = result.front();
     REQUIRE(tokens.size() == 2);
     REQUIRE(tokens[0] == vnd::Token(vnd::TokenType::UNKNOWN, R"(a")", vnd::CodeSourceLocation(filename, 1, 2)));
 }
@@ -1470,9 +1668,9 @@ TEST_CASE("tokenizer emit comment token", "[tokenizer]") {
     SECTION("Basic single-line comment") {
         constexpr std::string_view code2 = R"(// line comment)";
         vnd::Tokenizer tokenizer{code2, filename};
-        std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+        vnd::TokenStream result = tokenizer.tokenize();
         REQUIRE(result.size() == 1);
-        vnd::TokenVec tokens = result.front();
+        vnd::TokenSpan tokens = result.front();
         REQUIRE(tokens.size() == 2);
         REQUIRE(tokens[0] == vnd::Token(vnd::TokenType::COMMENT, "// line comment", vnd::CodeSourceLocation(filename, 1, 1)));
     }
@@ -1481,9 +1679,9 @@ TEST_CASE("tokenizer emit comment token", "[tokenizer]") {
         const std::string input = "// Comment with symbols !@#$%^&*()123456\n";
         vnd::Tokenizer tokenizer{input, filename};
 
-        std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+        vnd::TokenStream result = tokenizer.tokenize();
         REQUIRE(result.size() == 2);
-        vnd::TokenVec tokens = result.front();
+        vnd::TokenSpan tokens = result.front();
         REQUIRE(tokens.size() == 1);
         REQUIRE(tokens[0].getType() == vnd::TokenType::COMMENT);
         REQUIRE(tokens[0].getValue() == "// Comment with symbols !@#$%^&*()123456");
@@ -1494,9 +1692,9 @@ TEST_CASE("tokenizer emit comment token", "[tokenizer]") {
         const std::string input = "//\n";
         vnd::Tokenizer tokenizer{input, filename};
 
-        std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+        vnd::TokenStream result = tokenizer.tokenize();
         REQUIRE(result.size() == 2);
-        vnd::TokenVec tokens = result.front();
+        vnd::TokenSpan tokens = result.front();
         REQUIRE(tokens.size() == 1);
         REQUIRE(tokens[0].getType() == vnd::TokenType::COMMENT);
         REQUIRE(tokens[0].getValue() == "//");
@@ -1508,9 +1706,9 @@ TEST_CASE("tokenizer emit multiline comment token", "[tokenizer]") {
     SECTION("Basic multi-line comment") {
         constexpr std::string_view code2 = R"(/*multi\nline\ncomment*/)";
         vnd::Tokenizer tokenizer{code2, filename};
-        std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+        vnd::TokenStream result = tokenizer.tokenize();
         REQUIRE(result.size() == 1);
-        vnd::TokenVec tokens = result.front();
+        vnd::TokenSpan tokens = result.front();
         REQUIRE(tokens.size() == 2);
         REQUIRE(tokens[0] == vnd::Token(vnd::TokenType::COMMENT, R"(/*multi\nline\ncomment*/)", vnd::CodeSourceLocation(filename, 1, 1)));
     }
@@ -1518,13 +1716,24 @@ TEST_CASE("tokenizer emit multiline comment token", "[tokenizer]") {
     SECTION("Multi-line comment with asterisks inside") {
         const std::string input = "/* This * is * a * multi-line comment */";
         vnd::Tokenizer tokenizer{input, filename};
-        std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+        vnd::TokenStream result = tokenizer.tokenize();
         REQUIRE(result.size() == 1);
-        vnd::TokenVec tokens = result.front();
+        vnd::TokenSpan tokens = result.front();
         REQUIRE(tokens.size() == 2);
         REQUIRE(tokens[0].getType() == vnd::TokenType::COMMENT);
         REQUIRE(tokens[0].getValue() == "/* This * is * a * multi-line comment */");
     }
+
+    SECTION("Multi-line comment closed at an odd offset") {
+        const std::string input = "/*a*/ b";
+        vnd::Tokenizer tokenizer{input, filename};
+        vnd::TokenStream result = tokenizer.tokenize();
+        REQUIRE(result.size() == 1);
+        vnd::TokenSpan tokens = result.front();
+        REQUIRE(tokens.size() == 3);
+        REQUIRE(tokens[0] == vnd::Token(vnd::TokenType::COMMENT, "/*a*/", vnd::CodeSourceLocation(filename, 1, 1)));
+        REQUIRE(tokens[1] == vnd::Token(vnd::TokenType::IDENTIFIER, "b", vnd::CodeSourceLocation(filename, 1, 7)));
+    }
 }
 
 TEST_CASE("tokenizer emit mixed Comments", "[tokenizer]") {
@@ -1532,9 +1741,9 @@ TEST_CASE("tokenizer emit mixed Comments", "[tokenizer]") {
         const std::string input = "// Single line\n/* Multi-line */";
         vnd::Tokenizer tokenizer(input, "testFile");
 
-        std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+        vnd::TokenStream result = tokenizer.tokenize();
         REQUIRE(result.size() == 2);
-        vnd::TokenVec tokens = result.at(0);
+        vnd::TokenSpan tokens = result.at(0);
         REQUIRE(tokens[0].getType() == vnd::TokenType::COMMENT);
         REQUIRE(tokens[0].getValue() == "// Single line");
         tokens = result.at(1);
@@ -1546,9 +1755,9 @@ TEST_CASE("tokenizer emit mixed Comments", "[tokenizer]") {
         const std::string input = "/* Multi-line */\n// Single line";
         vnd::Tokenizer tokenizer(input, "testFile");
 
-        std::vector<vnd::TokenVec> result = tokenizer.tokenize();
+        vnd::TokenStream result = tokenizer.tokenize();
         REQUIRE(result.size() == 2);
-        vnd::TokenVec tokens = result.at(0);
+        vnd::TokenSpan tokens = result.at(0);
         REQUIRE(tokens[0].getType() == vnd::TokenType::COMMENT);
         REQUIRE(tokens[0].getValue() == "/* Multi-line */");
         tokens = result.at(1);
@@ -1566,6 +1775,377 @@ TEST_CASE("tokenizer edge cases for comments", "[tokenizer]") {
     REQUIRE(token.getValue() == "/* Comment with ** inside */");
 }
 
+TEST_CASE("SimdScanner kernels agree with the scalar fallback", "[tokenizer]") {
+    std::string input;
+    for(int i = 0; i < 40; ++i) { input += FORMAT("  \t identifier_{} /* a\r\nb\rc\n*x */ \"str\r\ning\" // tail\n", i); }
+    const auto scanAll = [&input] {
+        std::vector<std::size_t> results;
+        for(std::size_t pos = 0; pos < input.size(); ++pos) {
+            for(const auto &scan : {vnd::SimdScanner::skipBlockComment(input, pos), vnd::SimdScanner::skipString(input, pos),
+                                    vnd::SimdScanner::skipWhitespace(input, pos)}) {
+                results.insert(results.end(), {scan.position, scan.newlines, scan.lineStart});
+            }
+            results.push_back(vnd::SimdScanner::findNewline(input, pos));
+            results.push_back(vnd::SimdScanner::skipIdentifier(input, pos));
+        }
+        return results;
+    };
+    const auto best = vnd::SimdScanner::detectLevel();
+    vnd::SimdScanner::setLevel(vnd::SimdLevel::Scalar);
+    REQUIRE(vnd::SimdScanner::level() == vnd::SimdLevel::Scalar);
+    const auto expected = scanAll();
+    for(const auto level : {vnd::SimdLevel::SSE2, vnd::SimdLevel::AVX2}) {
+        if(level > best) { continue; }
+        vnd::SimdScanner::setLevel(level);
+        REQUIRE(scanAll() == expected);
+    }
+    vnd::SimdScanner::setLevel(best);
+    REQUIRE(vnd::SimdScanner::level() == best);
+}
+
+TEST_CASE("Tokenizer counts lines skipped by bulk scans", "[tokenizer]") {
+    using enum vnd::TokenType;
+    const std::string input = "a /* long comment spanning\r\nthree\rlines with padding */ b\n\n\t\t    \"string\nspanning two lines\" c";
+    vnd::Tokenizer tokenizer{input, filename};
+    const vnd::TokenStream result = tokenizer.tokenize();
+    REQUIRE(result.size() == 6);
+    REQUIRE(std::ranges::equal(result[0], vnd::TokenVec{vnd::Token(IDENTIFIER, "a", vnd::CodeSourceLocation(filename, 1, 1))}));
+    REQUIRE(result[2][0] == vnd::Token(COMMENT, "/* long comment spanning\r\nthree\rlines with padding */", vnd::CodeSourceLocation(filename, 1, 3)));
+    REQUIRE(result[2][1] == vnd::Token(IDENTIFIER, "b", vnd::CodeSourceLocation(filename, 3, 23)));
+    REQUIRE(result[4].empty());
+    REQUIRE(result[5][0] == vnd::Token(STRING, "string\nspanning two lines", vnd::CodeSourceLocation(filename, 5, 8)));
+    REQUIRE(result[5][1] == vnd::Token(IDENTIFIER, "c", vnd::CodeSourceLocation(filename, 6, 21)));
+}
+
+TEST_CASE("Tokenizer pull API matches tokenize", "[tokenizer]") {
+    const std::string input = "var a = (1,\n 2)\n\nb += c /* x\ny */ 'd'\nfun f() {\n}";
+    vnd::Tokenizer batch{input, filename};
+    const vnd::TokenStream expected = batch.tokenize();
+
+    vnd::Tokenizer tokens{input, filename};
+    REQUIRE(tokens.peek() == expected.tokens()[0]);
+    for(const auto &token : expected.tokens()) { REQUIRE(tokens.next() == token); }
+    REQUIRE(tokens.next().isType(vnd::TokenType::EOFT));
+    REQUIRE(tokens.peek().isType(vnd::TokenType::EOFT));
+    REQUIRE_FALSE(tokens.nextStatement().has_value());
+
+    vnd::Tokenizer statements{input, filename};
+    for(const auto &statement : expected) {
+        const auto pulled = statements.nextStatement();
+        REQUIRE(pulled.has_value());
+        REQUIRE(std::ranges::equal(*pulled, statement));
+    }
+    REQUIRE_FALSE(statements.nextStatement().has_value());
+}
+
+TEST_CASE("Tokenizer nextStatement skips tokens read with next", "[tokenizer]") {
+    using enum vnd::TokenType;
+    const std::string input = "a b c\nd";
+    vnd::Tokenizer tokenizer{input, filename};
+    REQUIRE(tokenizer.next() == vnd::Token(IDENTIFIER, "a", vnd::CodeSourceLocation(filename, 1, 1)));
+    const auto first = tokenizer.nextStatement();
+    REQUIRE(first.has_value());
+    REQUIRE(std::ranges::equal(*first, vnd::TokenVec{vnd::Token(IDENTIFIER, "b", vnd::CodeSourceLocation(filename, 1, 3)),
+                                                     vnd::Token(IDENTIFIER, "c", vnd::CodeSourceLocation(filename, 1, 5))}));
+    REQUIRE(tokenizer.next() == vnd::Token(IDENTIFIER, "d", vnd::CodeSourceLocation(filename, 2, 1)));
+    const auto last = tokenizer.nextStatement();
+    REQUIRE(last.has_value());
+    REQUIRE(std::ranges::equal(*last, vnd::TokenVec{vnd::Token(EOFT, "", vnd::CodeSourceLocation(filename, 2, 2))}));
+    REQUIRE_FALSE(tokenizer.nextStatement().has_value());
+}
+
+TEST_CASE("Tokenizer lexes operators without allocating", "[tokenizer]") {
+    std::string input;
+    for(int i = 0; i < 200; ++i) { input += "a += -b * c-- / (d != e) && !f || g %= h ^ i\n"; }
+    vnd::Tokenizer tokenizer{input, filename};
+    // The first statements grow the token window to its steady-state size.
+    for(int i = 0; i < 10; ++i) { REQUIRE(tokenizer.nextStatement().has_value()); }
+    const auto before = allocationCount.load();
+    std::size_t statements = 0;
+    while(tokenizer.nextStatement()) { ++statements; }
+    REQUIRE(allocationCount.load() == before);
+    REQUIRE(statements > 180);
+    const auto counted = std::make_unique<int>(0);
+    REQUIRE(allocationCount.load() > before);
+}
+
+TEST_CASE("Tokenizer reset reuses the tokenizer for another input", "[tokenizer]") {
+    const std::string first = "var a = (1 + b)\nfun f() {\n  return a\n}";
+    const std::string second = "c -= 2\nd";
+    vnd::Tokenizer tokenizer{first, filename};
+    const vnd::TokenStream expected = tokenizer.tokenize();
+    const vnd::TokenStream again = tokenizer.tokenize();
+    REQUIRE(std::ranges::equal(again.tokens(), expected.tokens()));
+    REQUIRE(again.statements() == expected.statements());
+
+    tokenizer.reset(second, filename);
+    vnd::Tokenizer fresh{second, filename};
+    const vnd::TokenStream expectedSecond = fresh.tokenize();
+    REQUIRE(std::ranges::equal(tokenizer.lex().tokens(), expectedSecond.tokens()));
+    REQUIRE(tokenizer.next() == expectedSecond.tokens().front());
+
+    // Once the buffers have grown, lexing the same input again allocates nothing.
+    tokenizer.reset(first, filename);
+    REQUIRE(std::ranges::equal(tokenizer.lex().tokens(), expected.tokens()));
+    const auto before = allocationCount.load();
+    std::size_t lexed = 0;
+    for(int i = 0; i < 10; ++i) {
+        tokenizer.reset(first, filename);
+        lexed += tokenizer.lex().tokenCount();
+    }
+    REQUIRE(allocationCount.load() == before);
+    REQUIRE(lexed == 10 * expected.tokenCount());
+}
+
+TEST_CASE("Tokenizer allocates its token buffer from an arena", "[tokenizer]") {
+    const std::string input = "var a = (1 + b)\nfun f() {\n  return a\n}";
+    vnd::Tokenizer plain{input, filename};
+    const vnd::TokenStream expected = plain.tokenize();
+    vnd::Arena arena;
+    vnd::ArenaResource resource{arena};
+    vnd::Tokenizer tokenizer{input, filename, &resource};
+    const auto &tokens = tokenizer.lex();
+    REQUIRE(std::ranges::equal(tokens.tokens(), expected.tokens()));
+    REQUIRE(tokens.statements() == expected.statements());
+    REQUIRE(arena.bytesUsed() >= tokens.tokenCount() * sizeof(vnd::Token));
+}
+
+TEST_CASE("Tokenizer tokenizeParallel matches tokenize", "[tokenizer]") {
+    std::string input;
+    for(int i = 0; i < 200; ++i) {
+        input += FORMAT("var a{} = (1,\n  {}) + b[2]\n", i, i);
+        input += "\"multi-line\nstring; with\nan unknown character\"\n";
+        input += "/* block\ncomment; */ fun f() {\n  return 'c'\n}\n\n";
+    }
+    vnd::Tokenizer sequential{input, filename};
+    const vnd::TokenStream expected = sequential.tokenize();
+    for(const std::size_t threads : {2, 3, 8, 64}) {
+        vnd::Tokenizer parallel{input, filename};
+        const vnd::TokenStream result = parallel.tokenizeParallel(threads, 16);
+        REQUIRE(std::ranges::equal(result.tokens(), expected.tokens()));
+        REQUIRE(result.statements() == expected.statements());
+    }
+    vnd::Tokenizer small{input, filename};
+    REQUIRE(std::ranges::equal(small.tokenizeParallel(8).tokens(), expected.tokens()));
+}
+
+TEST_CASE("Tokenizer tokenizeParallel reports the first error", "[tokenizer]") {
+    std::string input;
+    for(int i = 0; i < 100; ++i) { input += "a = (b +\n c)\n"; }
+    const std::string bracketFirst = input + ")\n" + input + ";\n";
+    vnd::Tokenizer brackets{bracketFirst, filename};
+    REQUIRE_THROWS_MATCHES(brackets.tokenizeParallel(4, 16), std::runtime_error, MessageMatches(ContainsSubstring("Mismatch bracket")));
+    const std::string unknownFirst = input + ";\n" + input + ")\n";
+    vnd::Tokenizer unknown{unknownFirst, filename};
+    REQUIRE_THROWS_MATCHES(unknown.tokenizeParallel(4, 16), std::runtime_error,
+                           MessageMatches(ContainsSubstring("Unknown Character ';' (line 201, column 1)")));
+}
+
+TEST_CASE("Tokenizer incremental tokenize matches a full tokenize", "[tokenizer]") {
+    std::string input;
+    for(int i = 0; i < 20; ++i) { input += FORMAT("var a{} = (1,\n  {}) + b[2]\nfun f{}() {{\n  return \"s;\"\n}}\n\n", i, i, i); }
+    vnd::Tokenizer first{input, filename};
+    const vnd::TokenStream previous = first.tokenize();
+    const auto at = [&input](std::string_view text) { return input.find(text); };
+    const std::vector<vnd::SourceEdit> edits{{at("a7 ="), at("a7 =") + 2, "renamed"},
+                                             {at("b[2]\nfun f9"), at("b[2]\nfun f9"), "c +\n "},
+                                             {at("var a3"), at("var a5"), ""},
+                                             {at("}\n\nvar a11"), at("}\n\nvar a12"), ""},
+                                             {0, 0, "\n\nx\n"},
+                                             {input.size(), input.size(), "y z\nw"},
+                                             {at("s;\"\n}\n\nvar a12") + 1, at("s;\"\n}\n\nvar a12") + 2, "\n;"}};
+    for(const auto &edit : edits) {
+        const auto edited = edit.apply(input);
+        vnd::Tokenizer full{edited, filename};
+        const vnd::TokenStream expected = full.tokenize();
+        vnd::Tokenizer incremental{edited, filename};
+        const auto result = incremental.tokenize(previous, edit);
+        REQUIRE(std::ranges::equal(result.tokens.tokens(), expected.tokens()));
+        REQUIRE(result.tokens.statements() == expected.statements());
+        REQUIRE(result.relexBegin <= result.relexEnd);
+        REQUIRE(result.tokens.size() - result.relexEnd == previous.size() - result.previousRelexEnd);
+    }
+    const auto renamed = edits.front().apply(input);
+    vnd::Tokenizer local{renamed, filename};
+    const auto result = local.tokenize(previous, edits.front());
+    REQUIRE(result.relexEnd - result.relexBegin < 4);
+}
+
+TEST_CASE("SourceManager resolves offsets to lines and columns", "[token]") {
+    const std::string input = "ab\ncd\r\nef\rg";
+    const auto fileId = vnd::SourceManager::addFile(filename, input);
+    const auto &file = vnd::SourceManager::get(fileId);
+    REQUIRE(file.fileName == filename);
+    REQUIRE(file.lineStarts == std::vector<std::uint32_t>{0, 3, 7, 10});
+    REQUIRE(file.locate(0) == vnd::CodeSourceLocation(filename, 1, 1));
+    REQUIRE(file.locate(2) == vnd::CodeSourceLocation(filename, 1, 3));
+    REQUIRE(file.locate(4) == vnd::CodeSourceLocation(filename, 2, 2));
+    REQUIRE(file.locate(7) == vnd::CodeSourceLocation(filename, 3, 1));
+    REQUIRE(file.locate(10) == vnd::CodeSourceLocation(filename, 4, 1));
+    const vnd::Token token{vnd::TokenType::IDENTIFIER, fileId, 7, 2};
+    REQUIRE(token == vnd::Token(vnd::TokenType::IDENTIFIER, "ef", vnd::CodeSourceLocation(filename, 3, 1)));
+}
+
+TEST_CASE("SourceManager line-start table is SIMD-independent and answers line queries", "[token]") {
+    std::string input;
+    for(int i = 0; i < 40; ++i) { input += FORMAT("line {}\r\n\rmixed\nbreaks {}\r", i, std::string(C_ST(i), 'x')); }
+    const auto best = vnd::SimdScanner::detectLevel();
+    vnd::SimdScanner::setLevel(vnd::SimdLevel::Scalar);
+    const auto expected = vnd::SimdScanner::lineStarts(input);
+    REQUIRE(expected.size() == 161);
+    for(const auto level : {vnd::SimdLevel::SSE2, vnd::SimdLevel::AVX2}) {
+        if(level > best) { continue; }
+        vnd::SimdScanner::setLevel(level);
+        REQUIRE(vnd::SimdScanner::lineStarts(input) == expected);
+    }
+    vnd::SimdScanner::setLevel(best);
+
+    const auto &file = vnd::SourceManager::get(vnd::SourceManager::addFile(filename, "ab\ncd\r\n\ref"));
+    REQUIRE(file.lineOf(0) == 1);
+    REQUIRE(file.lineOf(3) == 2);
+    REQUIRE(file.lineOf(5) == 2);
+    REQUIRE(file.lineOf(8) == 4);
+    REQUIRE(file.lineText(1) == "ab");
+    REQUIRE(file.lineText(2) == "cd");
+    REQUIRE(file.lineText(3).empty());
+    REQUIRE(file.lineText(4) == "ef");
+}
+
+TEST_CASE("SourceManager reuses synthetic entries", "[token]") {
+    constexpr std::string_view value = "value";
+    const vnd::CodeSourceLocation location{filename, 2, 3};
+    const vnd::Token first{vnd::TokenType::IDENTIFIER, value, location};
+    const vnd::Token second{vnd::TokenType::IDENTIFIER, value, location};
+    REQUIRE(first.getFileId() == second.getFileId());
+    REQUIRE(vnd::Token{}.getFileId() == vnd::SourceManager::unknownFileId);
+    REQUIRE(vnd::SourceManager::get(first.getFileId()).isSynthetic());
+    REQUIRE(first.getSourceLocation() == location);
+}
+
+TEST_CASE("SourceManager registers synthetic entries once across threads", "[token]") {
+    static constexpr std::string_view value = "shared";
+    const vnd::CodeSourceLocation location{filename, 7, 9};
+    const auto live = vnd::SourceManager::size();
+    std::vector<std::future<vnd::FileId>> workers;
+    for(int i = 0; i < 8; ++i) {
+        workers.emplace_back(std::async(std::launch::async, [&location] { return vnd::Token{vnd::TokenType::IDENTIFIER, value, location}.getFileId(); }));
+    }
+    std::vector<vnd::FileId> ids;
+    for(auto &worker : workers) { ids.push_back(worker.get()); }
+    REQUIRE(std::ranges::all_of(ids, [&ids](const vnd::FileId id) { return id == ids.front(); }));
+    REQUIRE(vnd::SourceManager::size() == live + 1);
+}
+
+TEST_CASE("SourceManager releases the entries of destroyed tokenizers", "[token]") {
+    const std::string input = "var a = (1 + b)\nc";
+    const auto live = vnd::SourceManager::size();
+    std::size_t grown = 0;
+    for(int i = 0; i < 1000; ++i) {
+        vnd::Tokenizer tokenizer{input, filename};
+        if(vnd::SourceManager::size() != live + 1) { ++grown; }
+        REQUIRE(tokenizer.lex().tokenCount() == 10);
+    }
+    REQUIRE(grown == 0);
+    REQUIRE(vnd::SourceManager::size() == live);
+
+    // A reused slot comes back under a new id, so the tokens of a released entry never name another file.
+    vnd::FileId released = 0;
+    {
+        vnd::Tokenizer first{input, filename};
+        released = first.lex().tokens().front().getFileId();
+    }
+    vnd::Tokenizer second{input, filename};
+    REQUIRE(second.lex().tokens().front().getFileId() != released);
+    REQUIRE(vnd::SourceManager::size() == live + 1);
+    REQUIRE(second.lex().tokens().front().getValue() == "var");
+
+    vnd::Tokenizer tokenizer{input, filename};
+    const auto fileId = tokenizer.lex().tokens().front().getFileId();
+    const std::string other = "x\ny\r\nz";
+    for(int i = 0; i < 100; ++i) { tokenizer.reset(i % 2 == 0 ? std::string_view{other} : std::string_view{input}, filename); }
+    REQUIRE(vnd::SourceManager::size() == live + 2);
+    REQUIRE(tokenizer.lex().tokens().front().getFileId() == fileId);
+    REQUIRE(vnd::SourceManager::get(fileId).lineStarts == std::vector<std::uint32_t>{0, 16});
+    {
+        vnd::Tokenizer moved{std::move(tokenizer)};
+        REQUIRE(vnd::SourceManager::size() == live + 2);
+    }
+    REQUIRE(vnd::SourceManager::size() == live + 1);
+}
+
+TEST_CASE("SourceManager patches the line starts of an edited entry", "[token]") {
+    const std::string input = "ab\r\ncd\ref\n\ngh\r";
+    const std::vector<vnd::SourceEdit> edits{{3, 3, "x"},        {2, 3, ""},     {3, 4, "\r"},    {0, 0, "\n"},    {0, 2, "z\r"},
+                                             {8, 9, "\n\r\n"}, {4, 10, "\r"}, {13, 13, "\n"}, {12, 13, ""},   {2, 12, ""},
+                                             {7, 7, "\r"},      {0, 13, ""},    {6, 8, "\n"},   {13, 13, "end"}};
+    for(const auto &edit : edits) {
+        const vnd::SourceHandle handle{filename, input};
+        const auto edited = edit.apply(input);
+        vnd::SourceManager::rebind(handle.get(), edited, edit);
+        REQUIRE(vnd::SourceManager::get(handle.get()).text.data() == edited.data());
+        REQUIRE(vnd::SourceManager::get(handle.get()).lineStarts == vnd::SimdScanner::lineStarts(edited));
+    }
+}
+
+TEST_CASE("Parser edits a document in place without growing the SourceManager", "[parser]") {
+    std::array<std::string, 2> buffers;
+    for(int i = 0; i < 10; ++i) { buffers[0] += FORMAT("var a{} = {} + b[2] * c\nfun f{}(x: i32): i32 {{\nreturn x\n}}\n", i, i, i); }
+    vnd::Parser parser{buffers[0], filename};
+    vnd::TokenStream tokens;
+    auto statements = parser.parse(tokens);
+    const auto fileId = tokens.tokens().front().getFileId();
+    const auto live = vnd::SourceManager::size();
+    std::size_t grown = 0;
+    std::size_t stale = 0;
+    for(std::size_t i = 0; i < 200; ++i) {
+        const auto &text = buffers[i % 2];
+        const auto declaration = FORMAT("var a{} = ", i % 10);
+        const auto begin = text.find(declaration) + declaration.size();
+        const auto replacement = i % 3 == 0 ? FORMAT("(\n{}\r\n)", i) : FORMAT("{}", i);
+        const vnd::SourceEdit edit{begin, text.find(" + b[2]", begin), replacement};
+        auto &edited = buffers[(i + 1) % 2];
+        edited = edit.apply(text);
+        statements = parser.parse(tokens, std::move(statements), edited, edit);
+        if(vnd::SourceManager::size() != live) { ++grown; }
+        if(vnd::SourceManager::get(fileId).lineStarts != vnd::SimdScanner::lineStarts(edited)) { ++stale; }
+    }
+    REQUIRE(grown == 0);
+    REQUIRE(stale == 0);
+    REQUIRE(tokens.tokens().front().getFileId() == fileId);
+
+    vnd::Parser full{buffers[0], filename};
+    vnd::TokenStream expectedTokens;
+    const auto expected = full.parse(expectedTokens);
+    REQUIRE(std::ranges::equal(tokens.tokens(), expectedTokens.tokens()));
+    REQUIRE(statements.size() == expected.size());
+    for(std::size_t index = 0; index < expected.size(); ++index) {
+        REQUIRE(statements[index].get_token() == expected[index].get_token());
+        REQUIRE((statements[index].get_root() == nullptr) == (expected[index].get_root() == nullptr));
+        if(expected[index].get_root() == nullptr) { continue; }
+        REQUIRE(statements[index].get_root()->print() == expected[index].get_root()->print());
+    }
+}
+
+TEST_CASE("Tokenizer stores statements as ranges of one token buffer", "[tokenizer]") {
+    using enum vnd::TokenType;
+    const std::string input = "var a = (1,\n 2)\n\nb";
+    vnd::Tokenizer tokenizer{input, filename};
+    const vnd::TokenStream result = tokenizer.tokenize();
+    REQUIRE(result.size() == 3);
+    REQUIRE(result.tokenCount() == 10);
+    REQUIRE(result.statements() ==
+            std::vector<vnd::StatementRange>{vnd::StatementRange{0, 8}, vnd::StatementRange{8, 8}, vnd::StatementRange{8, 10}});
+    REQUIRE(result[0].data() == result.tokens().data());
+    REQUIRE(result[2].data() == result.tokens().data() + 8);
+    REQUIRE(result[0].back() == vnd::Token(CLOSE_PARENTESIS, ")", vnd::CodeSourceLocation(filename, 2, 3)));
+    REQUIRE(result.at(1).empty());
+    REQUIRE(result.back().back().isType(vnd::eofTokenType));
+    REQUIRE_THROWS_AS(result.at(3), std::out_of_range);
+    std::size_t counted = 0;
+    for(const auto statement : result) { counted += statement.size(); }
+    REQUIRE(counted == result.tokenCount());
+}
+
 TEST_CASE("Tokenizer emit exception for mismacted  paren", "[parser]") {
     vnd::Tokenizer tokenizer{"1 + 2 +( 2+3*3", filename};
     REQUIRE_THROWS_MATCHES(tokenizer.tokenize(), std::runtime_error, MessageMatches(ContainsSubstring("Mismatch bracket")));
@@ -2215,6 +2795,7 @@ TEST_CASE("comp_NodeType function", "[parser]") {
     REQUIRE(std::string(comp_NodeType(NodeType::Type)) == "TYPE");
     REQUIRE(std::string(comp_NodeType(NodeType::Index)) == "IDX");
     REQUIRE(std::string(comp_NodeType(NodeType::Array)) == "ARR");
+    REQUIRE(std::string(comp_NodeType(NodeType::Declaration)) == "DECL");
 }
 
 TEST_CASE("Parser emit integer number node form exadecimal", "[parser]") {
@@ -2668,6 +3249,19 @@ TEST_CASE("Parser emit exception for nonexistent unary operator", "[parser]") {
 #endif
 }
 
+TEST_CASE("Parser emit exception for operator ending the expression", "[parser]") {
+    vnd::Parser tokenizer{"1 + -", filename};
+#if defined(_WIN32) || defined(__WIN32__) || defined(WIN32)
+    REQUIRE_THROWS_MATCHES(
+        tokenizer.parse(), vnd::ParserException,
+        Message(R"(Unexpected token: (type: MINUS_OPERATOR, value: '-', source location:(file:.\unknown.vn, line:1, column:5)))"));
+#else
+    REQUIRE_THROWS_MATCHES(
+        tokenizer.parse(), vnd::ParserException,
+        Message(R"(Unexpected token: (type: MINUS_OPERATOR, value: '-', source location:(file:./unknown.vn, line:1, column:5)))"));
+#endif
+}
+
 TEST_CASE("NodeType formatter works as expected", "[formatter]") {
     using enum NodeType;  // shorthand for enum access
     REQ_FORMAT(BinaryExpression, "BINARY_EXPRESION");
@@ -2681,6 +3275,7 @@ TEST_CASE("NodeType formatter works as expected", "[formatter]") {
     REQ_FORMAT(Type, "TYPE");
     REQ_FORMAT(Index, "INDEX");
     REQ_FORMAT(Array, "ARRAY");
+    REQ_FORMAT(Declaration, "DECLARATION");
     REQ_FORMAT(Statement, "STATEMENT");
 }
 
@@ -2855,12 +3450,12 @@ TEST_CASE("Parser emit empty array node print", "[parser]") {
     REQUIRE(programAst.size() == 1);
     auto ast = programAst[0].get_root().get();
     REQUIRE(ast != nullptr);
-    REQUIRE(ast->getType() == NodeType::BinaryExpression);
+    REQUIRE(ast->getType() == NodeType::Declaration);
     REQUIRE(ast->get_parent() == nullptr);
-    const auto *binaryNode = ast->as<vnd::BinaryExpressionNode>();
-    REQUIRE(binaryNode != nullptr);
-    REQUIRE(binaryNode->getRight()->getType() == NodeType::Array);
-    const auto *arrayNode = binaryNode->getRight()->as<vnd::ArrayNode>();
+    const auto *declarationNode = ast->as<vnd::DeclarationNode>();
+    REQUIRE(declarationNode != nullptr);
+    REQUIRE(declarationNode->get_initializers()->getType() == NodeType::Array);
+    const auto *arrayNode = declarationNode->get_initializers()->as<vnd::ArrayNode>();
     REQUIRE(arrayNode != nullptr);
     REQUIRE(arrayNode->print() == "ARRAY()");
 }
@@ -2871,12 +3466,12 @@ TEST_CASE("Parser emit empty array compat node print", "[parser]") {
     REQUIRE(programAst.size() == 1);
     auto ast = programAst[0].get_root().get();
     REQUIRE(ast != nullptr);
-    REQUIRE(ast->getType() == NodeType::BinaryExpression);
+    REQUIRE(ast->getType() == NodeType::Declaration);
     REQUIRE(ast->get_parent() == nullptr);
-    const auto *binaryNode = ast->as<vnd::BinaryExpressionNode>();
-    REQUIRE(binaryNode != nullptr);
-    REQUIRE(binaryNode->getRight()->getType() == NodeType::Array);
-    const auto *arrayNode = binaryNode->getRight()->as<vnd::ArrayNode>();
+    const auto *declarationNode = ast->as<vnd::DeclarationNode>();
+    REQUIRE(declarationNode != nullptr);
+    REQUIRE(declarationNode->get_initializers()->getType() == NodeType::Array);
+    const auto *arrayNode = declarationNode->get_initializers()->as<vnd::ArrayNode>();
     REQUIRE(arrayNode != nullptr);
     REQUIRE(arrayNode->comp_print() == "ARRAY");
 }
@@ -2887,12 +3482,12 @@ TEST_CASE("Parser emit array node print", "[parser]") {
     REQUIRE(programAst.size() == 1);
     auto ast = programAst[0].get_root().get();
     REQUIRE(ast != nullptr);
-    REQUIRE(ast->getType() == NodeType::BinaryExpression);
+    REQUIRE(ast->getType() == NodeType::Declaration);
     REQUIRE(ast->get_parent() == nullptr);
-    const auto *binaryNode = ast->as<vnd::BinaryExpressionNode>();
-    REQUIRE(binaryNode != nullptr);
-    REQUIRE(binaryNode->getRight()->getType() == NodeType::Array);
-    const auto *arrayNode = binaryNode->getRight()->as<vnd::ArrayNode>();
+    const auto *declarationNode = ast->as<vnd::DeclarationNode>();
+    REQUIRE(declarationNode != nullptr);
+    REQUIRE(declarationNode->get_initializers()->getType() == NodeType::Array);
+    const auto *arrayNode = declarationNode->get_initializers()->as<vnd::ArrayNode>();
     REQUIRE(arrayNode != nullptr);
     REQUIRE(arrayNode->print() == FORMAT("ARRAY({})", arrayNode->get_elements()->comp_print()));
 }
@@ -2903,16 +3498,37 @@ TEST_CASE("Parser emit array compat node print", "[parser]") {
     REQUIRE(programAst.size() == 1);
     auto ast = programAst[0].get_root().get();
     REQUIRE(ast != nullptr);
-    REQUIRE(ast->getType() == NodeType::BinaryExpression);
+    REQUIRE(ast->getType() == NodeType::Declaration);
     REQUIRE(ast->get_parent() == nullptr);
-    const auto *binaryNode = ast->as<vnd::BinaryExpressionNode>();
-    REQUIRE(binaryNode != nullptr);
-    REQUIRE(binaryNode->getRight()->getType() == NodeType::Array);
-    const auto *arrayNode = binaryNode->getRight()->as<vnd::ArrayNode>();
+    const auto *declarationNode = ast->as<vnd::DeclarationNode>();
+    REQUIRE(declarationNode != nullptr);
+    REQUIRE(declarationNode->get_initializers()->getType() == NodeType::Array);
+    const auto *arrayNode = declarationNode->get_initializers()->as<vnd::ArrayNode>();
     REQUIRE(arrayNode != nullptr);
     REQUIRE(arrayNode->comp_print() == "ARRAY");
 }
 
+TEST_CASE("Parser emit declaration node", "[parser]") {
+    vnd::Parser parser{"var a, b: i32[2] = {1, 2}, f(c)\nconst d = 1\nval e: bool", filename};
+    const auto programAst = parser.parse();
+    REQUIRE(programAst.size() == 3);
+    const auto *full = programAst[0].get_root()->as<vnd::DeclarationNode>();
+    REQUIRE(full != nullptr);
+    REQUIRE(full->get_token().getValue() == "var");
+    REQUIRE(full->get_names()->comp_print() == "BINE(op:\",\" l:VAR(a), r:VAR(b))");
+    REQUIRE(full->get_declared_type()->getType() == NodeType::Type);
+    REQUIRE(full->get_initializers()->as<vnd::BinaryExpressionNode>()->getOp() == ",");
+    REQUIRE(full->get_names()->get_parent() == full);
+    const auto *inferred = programAst[1].get_root()->as<vnd::DeclarationNode>();
+    REQUIRE(inferred->get_declared_type() == nullptr);
+    REQUIRE(inferred->get_initializers()->getType() == NodeType::Number);
+    const auto *uninitialized = programAst[2].get_root()->as<vnd::DeclarationNode>();
+    REQUIRE(uninitialized->get_declared_type()->comp_print() == "TYPE(bool)");
+    REQUIRE(uninitialized->get_initializers() == nullptr);
+    REQUIRE(uninitialized->comp_print() == "DECL(n:VAR(e), t:TYPE(bool), i:)");
+    REQUIRE_NOTHROW(prettyPrint(*programAst[0].get_root()));
+}
+
 TEST_CASE("Parser emit empty callable node", "[parser]") {
     vnd::Parser parser("function()", filename);
     auto programAst = parser.parse();
@@ -2938,6 +3554,167 @@ TEST_CASE("Parser emit callable node", "[parser]") {
     REQUIRE(variableNode->get_call() != nullptr);
 }
 
+TEST_CASE("Parser incremental parse matches a full parse", "[parser]") {
+    std::string input;
+    for(int i = 0; i < 10; ++i) { input += FORMAT("var a{} = {} + b[2] * c\nfun f{}(x: i32): i32 {{\nreturn x\n}}\n", i, i, i); }
+    const std::string_view target = "a4 = 4 + b[2]";
+    const vnd::SourceEdit edit{input.find(target) + 5, input.find(target) + 6, "(7 - d)"};
+    vnd::Parser first{input, filename};
+    vnd::TokenStream tokens;
+    auto statements = first.parse(tokens);
+    REQUIRE(statements.size() == tokens.size());
+
+    const auto edited = edit.apply(input);
+    vnd::Parser full{edited, filename};
+    const auto expected = full.parse();
+    vnd::Parser incremental{edited, filename};
+    const auto result = incremental.parse(tokens, std::move(statements), edit);
+    REQUIRE(result.size() == expected.size());
+    REQUIRE(tokens.size() == expected.size());
+    for(std::size_t index = 0; index < expected.size(); ++index) {
+        REQUIRE(result[index].get_token() == expected[index].get_token());
+        REQUIRE((result[index].get_root() == nullptr) == (expected[index].get_root() == nullptr));
+        if(expected[index].get_root() == nullptr) { continue; }
+        REQUIRE(result[index].get_root()->print() == expected[index].get_root()->print());
+        REQUIRE(result[index].get_root()->get_token() == expected[index].get_root()->get_token());
+    }
+}
+
+TEST_CASE("Parser builds the AST in an arena", "[parser]") {
+    std::string input;
+    for(int i = 0; i < 50; ++i) { input += FORMAT("var a{}: i32[2] = {{1, -b[{}]}} + f(c, \"s\") * 2.5\n", i, i); }
+    vnd::Parser plain{input, filename};
+    const auto before = allocationCount.load();
+    const auto expected = plain.parse();
+    const auto plainAllocations = allocationCount.load() - before;
+
+    vnd::Arena arena;
+    vnd::Parser parser{input, filename, arena};
+    const auto start = allocationCount.load();
+    auto statements = parser.parse();
+    const auto arenaAllocations = allocationCount.load() - start;
+    REQUIRE(statements.size() == expected.size());
+    for(std::size_t index = 0; index < expected.size(); ++index) {
+        REQUIRE(statements[index].get_token() == expected[index].get_token());
+        REQUIRE((statements[index].get_root() == nullptr) == (expected[index].get_root() == nullptr));
+        if(expected[index].get_root() == nullptr) { continue; }
+        REQUIRE_FALSE(statements[index].get_root().get_deleter().owned);
+        REQUIRE(statements[index].get_root()->print() == expected[index].get_root()->print());
+    }
+    const auto *declaration = statements.front().get_root()->as<vnd::DeclarationNode>();
+    REQUIRE(declaration->get_initializers()->getType() == NodeType::BinaryExpression);
+    REQUIRE(arena.bytesUsed() > 0);
+    REQUIRE(arenaAllocations < plainAllocations);
+    statements.clear();
+    arena.release();
+    REQUIRE(arena.chunkCount() == 0);
+}
+
+TEST_CASE("Parser parses statements in parallel in source order", "[parser]") {
+    std::string input;
+    for(int i = 0; i < 300; ++i) {
+        input += FORMAT("var a{}: i32[2] = {{1, -b[{}]}} + f(c, \"s\") * 2.5\nfun g{}(x: i8) i8 {{\nreturn x + {}\n}}\n\n", i, i, i, i);
+    }
+    vnd::Parser parser{input, filename};
+    const auto tokens = parser.getTokenizer().tokenize();
+    const auto expected = parser.parseTokens(tokens);
+    const auto compare = [&expected](const std::vector<vnd::Statement> &statements) {
+        REQUIRE(statements.size() == expected.size());
+        for(std::size_t index = 0; index < expected.size(); ++index) {
+            REQUIRE(statements[index].get_token() == expected[index].get_token());
+            REQUIRE(statements[index].get_funData() == expected[index].get_funData());
+            REQUIRE((statements[index].get_root() == nullptr) == (expected[index].get_root() == nullptr));
+            if(expected[index].get_root() != nullptr) {
+                REQUIRE(statements[index].get_root()->print() == expected[index].get_root()->print());
+            }
+        }
+    };
+    compare(parser.parseTokensParallel(tokens, 4, 7));
+    compare(parser.parseTokensParallel(tokens, 3, 1));
+    compare(parser.parseTokensParallel(tokens, 1));
+    compare(parser.parseTokensParallel(tokens));
+
+    vnd::Arena arena;
+    vnd::Parser arenaParser{input, filename, arena};
+    auto statements = arenaParser.parseTokensParallel(tokens, 4, 16);
+    compare(statements);
+    REQUIRE_FALSE(statements.front().get_root().get_deleter().owned);
+    REQUIRE(arena.bytesUsed() > 0);
+    statements.clear();
+    arena.release();
+
+    const auto brokenInput = input + "break a\n" + input;
+    vnd::Parser broken{brokenInput, filename};
+    const auto brokenTokens = broken.getTokenizer().tokenize();
+    REQUIRE_THROWS_AS(broken.parseTokensParallel(brokenTokens, 4, 7), vnd::ParserException);
+}
+
+TEST_CASE("Parser parses deeply nested expressions without recursion", "[parser]") {
+    constexpr std::size_t depth = 100000;
+    const auto nested = std::string(depth, '(') + "a[1][]{2} + f(b, -c)" + std::string(depth, ')');
+    vnd::Parser nestedParser{nested, filename};
+    const auto nestedStatements = nestedParser.parse();
+    const std::string flat = "a[1][]{2} + f(b, -c)";
+    vnd::Parser flatParser{flat, filename};
+    REQUIRE(nestedStatements.front().get_root()->print() == flatParser.parse().front().get_root()->print());
+
+    // The trees below are as deep as the expressions are long: arena nodes are never destroyed one by one.
+    vnd::Arena arena;
+    std::string chain = "x = 0";
+    for(std::size_t term = 1; term < depth; ++term) { chain += term % 2 == 0 ? " - b" : " + -c"; }
+    vnd::Parser chainParser{chain, filename, arena};
+    const auto chainStatements = chainParser.parse();
+    const vnd::ASTNode *node = chainStatements.front().get_root()->as<vnd::BinaryExpressionNode>()->getRight().get();
+    std::size_t subtractions = 0;
+    while(node->getType() == NodeType::BinaryExpression) {
+        const auto *binary = node->as<vnd::BinaryExpressionNode>();
+        if(binary->getOp() == "-") {
+            ++subtractions;
+            REQUIRE(binary->getRight()->getType() == NodeType::Variable);
+        } else {
+            REQUIRE(binary->getRight()->getType() == NodeType::UnaryExpression);
+        }
+        node = binary->getLeft().get();
+    }
+    REQUIRE(subtractions == depth / 2 - 1);
+
+    const auto prefixes = "x = " + std::string(depth, '!') + "a";
+    vnd::Parser prefixParser{prefixes, filename, arena};
+    const auto prefixStatements = prefixParser.parse();
+    node = prefixStatements.front().get_root()->as<vnd::BinaryExpressionNode>()->getRight().get();
+    std::size_t operators = 0;
+    for(; node->getType() == NodeType::UnaryExpression; ++operators) { node = node->as<vnd::UnaryExpressionNode>()->getOperand().get(); }
+    REQUIRE(operators == depth);
+    REQUIRE(node->getType() == NodeType::Variable);
+}
+
+TEST_CASE("FunctionSignature reads a fun statement without touching its tokens", "[parser]") {
+    const std::string_view input = "fun f(x: i32, y: i8[2]) i8, bool {\n}\nfun g() {\n}";
+    vnd::Parser parser{input, filename};
+    const auto tokens = parser.getTokenizer().tokenize();
+    const auto signature = vnd::FunctionSignature::parse(tokens[0]);
+    REQUIRE(signature.name == "f");
+    REQUIRE(signature.parameters.size() == 10);
+    REQUIRE(signature.parameters.front().getValue() == "x");
+    REQUIRE(signature.parameters.back().getValue() == "]");
+    REQUIRE(signature.returnTypes == StrViewVec{"i8", "bool"});
+    REQUIRE(tokens[0][signature.returnTypesBegin].getValue() == "i8");
+    const auto empty = vnd::FunctionSignature::parse(tokens[2]);
+    REQUIRE(empty.name == "g");
+    REQUIRE(empty.parameters.empty());
+    REQUIRE(empty.returnTypes.empty());
+
+    const std::vector<vnd::Token> before(tokens.tokens().begin(), tokens.tokens().end());
+    const auto statements = parser.parseTokens(tokens);
+    REQUIRE(std::ranges::equal(tokens.tokens(), before));
+    REQUIRE(statements[0].get_funData() == signature.returnTypes);
+    REQUIRE(statements[0].get_funData().front().data() == input.data() + input.find(") i8") + 2);
+    const auto *call = statements[0].get_root()->as<vnd::VariableNode>();
+    REQUIRE(call != nullptr);
+    REQUIRE(call->getName() == "f");
+    REQUIRE(call->is_call());
+}
+
 TEST_CASE("NullptrNode basic functionality", "[NullptrNode]") {
     vnd::Parser parser("nullptr", filename);
     auto programAst = parser.parse();
@@ -3033,6 +3810,18 @@ TEST_CASE("prettyPrint: tipe assignment", "[prettyPrint]") {
     REQUIRE_NOTHROW(prettyPrint(*ast, "", true));
 }
 
+TEST_CASE("prettyPrint: declaration without names", "[prettyPrint]") {
+    const vnd::DeclarationNode empty{vnd::Token{}, nullptr, nullptr, nullptr};
+    REQUIRE_NOTHROW(prettyPrint(empty, "", true));
+    vnd::Parser parser("var a: i32 = 1", filename);
+    auto programAst = parser.parse();
+    REQUIRE(programAst.size() == 1);
+    const auto *declaration = programAst[0].get_root()->as<vnd::DeclarationNode>();
+    REQUIRE(declaration != nullptr);
+    const vnd::DeclarationNode unnamed{declaration->get_token(), nullptr, MAKE_UNIQUE(vnd::TypeNode, declaration->get_token()), nullptr};
+    REQUIRE_NOTHROW(prettyPrint(unnamed, "", true));
+}
+
 TEST_CASE("prettyPrint: array type assignment", "[prettyPrint]") {
     vnd::Parser parser("asd : i32[2], asd2 : i32[2][]", filename);
     auto programAst = parser.parse();
@@ -3076,6 +3865,99 @@ TEST_CASE("prettyPrint: Unknown node type", "[prettyPrint]") {
     REQUIRE_NOTHROW(prettyPrint(unknownNode));
 }
 
+TEST_CASE("visit dispatches on the node kind", "[visitor]") {
+    vnd::Parser parser{"a[1] = -(2 + 3.5f) * {true, 'c', \"s\", nullptr, 1i, 2.0if, 4.0}\nvar b: i8", filename};
+    const auto ast = parser.parse();
+    REQUIRE(ast.size() == 2);
+    std::vector<std::string> visited;
+    const auto record = vnd::Overloaded{
+        [&visited](const vnd::BinaryExpressionNode &node) { visited.emplace_back(node.getOp()); },
+        [&visited](const vnd::UnaryExpressionNode &node) { visited.emplace_back(FORMAT("unary {}", node.getOp())); },
+        [&visited](const vnd::VariableNode &node) { visited.emplace_back(node.getName()); },
+        [&visited]<typename T>(const vnd::NumberNode<T> &node) { visited.emplace_back(FORMAT("{}", node.getNumberType())); },
+        [&visited]<typename T>(const vnd::LiteralNode<T> &node) { visited.emplace_back(FORMAT("{}", node.getType())); },
+        [&visited](const vnd::NullptrNode &) { visited.emplace_back("nullptr"); },
+        [&visited](const vnd::TypeNode &node) { visited.emplace_back(node.get_value()); },
+        [&visited](const vnd::ArrayNode &) { visited.emplace_back("array"); },
+        [&visited](const vnd::IndexNode &) { visited.emplace_back("index"); },
+        [&visited](const vnd::ASTNode &) { visited.emplace_back("other"); },
+    };
+    const auto walk = [&record](const auto &self, const vnd::ASTNode &node) -> void {
+        vnd::visit(node, record);
+        if(const auto *binary = vnd::node_cast<vnd::BinaryExpressionNode>(node)) {
+            self(self, *binary->getLeft());
+            self(self, *binary->getRight());
+        } else if(const auto *unary = vnd::node_cast<vnd::UnaryExpressionNode>(node)) {
+            self(self, *unary->getOperand());
+        } else if(const auto *array = vnd::node_cast<vnd::ArrayNode>(node)) {
+            self(self, *array->get_elements());
+        }
+    };
+    walk(walk, *ast[0].get_root());
+    REQUIRE(visited == std::vector<std::string>{"=",    "a",    "*",    "unary -", "+",       "INTEGER", "FLOAT",     "array",
+                                                ",",    ",",    ",",    ",",       ",",       ",",       "BOOLEAN",   "CHAR",
+                                                "STRING", "nullptr", "IMAGINARY", "IMAGINARY_F", "DOUBLE"});
+    REQUIRE(vnd::node_cast<vnd::VariableNode>(*ast[0].get_root()) == nullptr);
+    REQUIRE(vnd::node_cast<vnd::TypeNode>(*ast[1].get_root()->as<vnd::DeclarationNode>()->get_declared_type()) != nullptr);
+
+    visited.clear();
+    vnd::visit(ast[1], record);
+    vnd::visit(UnknownNode{}, record);
+    REQUIRE(visited == std::vector<std::string>{"other", "other"});
+    REQUIRE(ast[1].getKind() == vnd::NodeKind::Statement);
+    REQUIRE(UnknownNode{}.getKind() == vnd::NodeKind::Unknown);
+}
+
+TEST_CASE("FlatAST mirrors the parsed tree", "[flatAST]") {
+    vnd::Parser parser{"a[1] = -(2 + 3.5f)\nfun f(x: i32) i8, bool {\nb = g('c', true)\n}", filename};
+    const auto statements = parser.parse();
+    const auto ast = vnd::FlatAST::fromStatements(statements);
+    REQUIRE(ast.statementCount() == statements.size());
+    REQUIRE(ast.statementToken(1).getType() == vnd::TokenType::K_FUN);
+    REQUIRE(ast.funData(1) == statements[1].get_funData());
+
+    const auto root = ast.statementRoot(0);
+    REQUIRE(root == 0);
+    REQUIRE(ast.kind(root) == vnd::NodeKind::BinaryExpression);
+    REQUIRE(ast.role(root) == vnd::NodeRole::Root);
+    REQUIRE(ast.text(root) == "=");
+    REQUIRE(ast.token(root) == statements[0].get_root()->get_token());
+
+    const auto left = ast.child(root, vnd::NodeRole::Left);
+    REQUIRE(left == ast.firstChild(root));
+    REQUIRE(ast.kind(left) == vnd::NodeKind::Variable);
+    REQUIRE(ast.text(left) == "a");
+    REQUIRE_FALSE(ast.isCall(left));
+    const auto index = ast.child(left, vnd::NodeRole::Index);
+    REQUIRE(ast.kind(index) == vnd::NodeKind::Index);
+    REQUIRE(ast.child(index, vnd::NodeRole::Array) == vnd::noNode);
+    const auto one = ast.child(index, vnd::NodeRole::Elements);
+    REQUIRE(std::get<int>(ast.number(one)) == 1);
+
+    const auto right = ast.child(root, vnd::NodeRole::Right);
+    REQUIRE(right == ast.nextSibling(left));
+    REQUIRE(ast.nextSibling(right) == vnd::noNode);
+    REQUIRE(ast.kind(right) == vnd::NodeKind::UnaryExpression);
+    REQUIRE(ast.text(right) == "-");
+    const auto sum = ast.child(right, vnd::NodeRole::Operand);
+    REQUIRE(ast.text(sum) == "+");
+    REQUIRE(std::get<int>(ast.number(ast.child(sum, vnd::NodeRole::Left))) == 2);
+    REQUIRE(std::get<float>(ast.number(ast.child(sum, vnd::NodeRole::Right))) == 3.5f);
+
+    const auto call = ast.child(ast.statementRoot(2), vnd::NodeRole::Right);
+    REQUIRE(ast.text(call) == "g");
+    REQUIRE(ast.isCall(call));
+    const auto arguments = ast.child(call, vnd::NodeRole::Call);
+    REQUIRE(ast.text(arguments) == ",");
+    const auto character = ast.child(arguments, vnd::NodeRole::Left);
+    REQUIRE(ast.kind(character) == vnd::NodeKind::Char);
+    REQUIRE(ast.character(character) == 'c');
+    REQUIRE(ast.text(character).empty());
+    REQUIRE(ast.boolean(ast.child(arguments, vnd::NodeRole::Right)));
+
+    REQUIRE(vnd::FlatAST::fromStatements({}).size() == 0);
+}
+
 TEST_CASE("printParentNode: no parent", "[printParentNode]") {
     vnd::Parser parser{"2 + 3 + (4.2 / 2) * 3 + y", "input.vn"};
     auto programAst = parser.parse();
@@ -3216,14 +4098,136 @@ TEST_CASE("Transpiler transpile initialization instruction", "[transpiler]") {
     [[maybe_unused]] auto unused = fs::remove_all(fs::path(VANDIOR_BUILDFOLDER));
     vnd::Transpiler transpiler{"var num1, num2: u8 = 12, 45", "input.vn"};
     const auto code = transpiler.transpile();
-    REQUIRE(code == "uint8_t num1 = 12, num2  = 45\n");
+    REQUIRE(code == "uint8_t num1 = 12, num2 = 45\n");
+}
+
+TEST_CASE("Transpiler transpile declaration with string initializers", "[transpiler]") {
+    [[maybe_unused]] auto unused = fs::remove_all(fs::path(VANDIOR_BUILDFOLDER));
+    vnd::Transpiler transpiler{"var s, t: string = \"a=b, c\", \"d\"\nconst n = 1", "input.vn"};
+    const auto code = transpiler.transpile();
+    REQUIRE(code == "std::string_view s = \"a=b, c\", t = \"d\"\nconst auto n = 1\n");
 }
 
 TEST_CASE("Transpiler transpile vector initialization instruction", "[transpiler]") {
     [[maybe_unused]] auto unused = fs::remove_all(fs::path(VANDIOR_BUILDFOLDER));
     vnd::Transpiler transpiler{"var nums: u8[] = u8[]{12, 45}", "input.vn"};
     const auto code = transpiler.transpile();
-    REQUIRE(code == "vnd::vector<uint8_t> nums  = vnd::vector<uint8_t>({12, 45})\n");
+    REQUIRE(code == "vnd::vector<uint8_t> nums = vnd::vector<uint8_t>({12, 45})\n");
+}
+
+TEST_CASE("Transpiler transpile every fun into its own translation unit", "[transpiler]") {
+    [[maybe_unused]] auto unused = fs::remove_all(fs::path(VANDIOR_BUILDFOLDER));
+    vnd::Transpiler transpiler{"const n = 1\nfun f(a: i8) i8 {\nreturn a\n}\nfun f() i8, i8 {\nreturn 1, 2\n}\nmain {\nvar x = f(n)\n}", "input.vn"};
+    const auto files = transpiler.transpileUnits(2);
+    REQUIRE(files.size() == 4);
+    REQUIRE(files[0].name == "input.hpp");
+    REQUIRE(files[1].name == "input.cpp");
+    REQUIRE(files[2].name == "input_f.cpp");
+    REQUIRE(files[3].name == "input_f-2.cpp");
+    REQUIRE_THAT(files[0].code, ContainsSubstring("#pragma once\n"));
+    REQUIRE_THAT(files[0].code, ContainsSubstring("inline const auto n = 1;\nauto f(int8_t a) -> int8_t;\nauto f() -> std::tuple< int8_t , int8_t>;\n"));
+    REQUIRE_THAT(files[1].code, EndsWith("#include \"input.hpp\"\n\nint main(int argc, char **argv) {\nauto x = f(n)\n}\n"));
+    REQUIRE_THAT(files[2].code, EndsWith("#include \"input.hpp\"\n\nauto f(int8_t a) -> int8_t {\nreturn a\n}\n"));
+    REQUIRE_THAT(files[3].code, EndsWith("#include \"input.hpp\"\n\nauto f() -> std::tuple< int8_t , int8_t> {\nreturn 1, 2\n}\n"));
+    const fs::path srcFolder = (fs::path(VANDIOR_BUILDFOLDER) / "src").make_preferred();
+    for(const auto &file : files) {
+        const auto path = (srcFolder / file.name).make_preferred();
+        REQUIRE(fs::exists(path));
+        REQUIRE(vnd::readFromFile(path.string()) == file.code);
+    }
+}
+
+TEST_CASE("Transpiler names the units of overloads apart from the other funs", "[transpiler]") {
+    [[maybe_unused]] auto unused = fs::remove_all(fs::path(VANDIOR_BUILDFOLDER));
+    vnd::Transpiler transpiler{"fun f(a: i8) i8 {\nreturn a\n}\nfun f_2() i8 {\nreturn 2\n}\nfun f() i8 {\nreturn 1\n}", "input.vn"};
+    const auto files = transpiler.transpileUnits(1);
+    REQUIRE(files.size() == 5);
+    REQUIRE(files[2].name == "input_f.cpp");
+    REQUIRE(files[3].name == "input_f_2.cpp");
+    REQUIRE(files[4].name == "input_f-2.cpp");
+    REQUIRE_THAT(files[4].code, EndsWith("auto f() -> int8_t {\nreturn 1\n}\n"));
+}
+
+TEST_CASE("Transpiler regenerates only the changed functions", "[transpiler]") {
+    [[maybe_unused]] auto unused = fs::remove_all(fs::path(VANDIOR_BUILDFOLDER));
+    const fs::path srcFolder = (fs::path(VANDIOR_BUILDFOLDER) / "src").make_preferred();
+    const auto fFile = (srcFolder / "input_f.cpp").make_preferred();
+    const auto gFile = (srcFolder / "input_g.cpp").make_preferred();
+    {
+        vnd::Transpiler transpiler{"fun f() i8 {\nreturn 1\n}\nfun g() i8 {\nreturn 2\n}\nmain {\n}", "input.vn"};
+        const auto files = transpiler.transpileUnits(2);
+        REQUIRE(std::ranges::none_of(files, &vnd::Transpiler::GeneratedFile::reused));
+        REQUIRE(fs::exists(fs::path(VANDIOR_BUILDFOLDER) / "input.manifest"));
+    }
+    const auto fTime = fs::last_write_time(fFile);
+    const auto mainTime = fs::last_write_time(srcFolder / "input.cpp");
+    {
+        // f only moves after g, g gets a new body.
+        vnd::Transpiler transpiler{"fun g() i8 {\nreturn 3\n}\nfun f() i8 {\nreturn 1\n}\nmain {\n}", "input.vn"};
+        const auto files = transpiler.transpileUnits(2);
+        REQUIRE(files[2].name == "input_g.cpp");
+        REQUIRE_FALSE(files[2].reused);
+        REQUIRE(files[3].name == "input_f.cpp");
+        REQUIRE(files[3].reused);
+        REQUIRE(files[3].code.empty());
+        REQUIRE_THAT(vnd::readFromFile(gFile.string()), ContainsSubstring("return 3\n"));
+        REQUIRE(fs::last_write_time(fFile) == fTime);
+        REQUIRE(fs::last_write_time(srcFolder / "input.cpp") == mainTime);
+    }
+    {
+        vnd::Transpiler transpiler{"fun f() i8 {\nreturn 1\n}\nmain {\n}", "input.vn"};
+        const auto files = transpiler.transpileUnits(2);
+        REQUIRE(files.size() == 3);
+        REQUIRE(files[2].reused);
+        REQUIRE(fs::exists(fFile));
+        REQUIRE_FALSE(fs::exists(gFile));
+    }
+}
+
+TEST_CASE("Transpiler regenerates every function written by another generator", "[transpiler]") {
+    [[maybe_unused]] auto unused = fs::remove_all(fs::path(VANDIOR_BUILDFOLDER));
+    const auto manifestPath = fs::path(VANDIOR_BUILDFOLDER) / "input.manifest";
+    const std::string_view input = "fun f() i8 {\nreturn 1\n}\nfun g() i8 {\nreturn 2\n}\nmain {\n}";
+    {
+        vnd::Transpiler transpiler{input, "input.vn"};
+        std::ignore = transpiler.transpileUnits(2);
+    }
+    auto manifest = vnd::readFromFile(manifestPath.string());
+    REQUIRE(manifest.starts_with("generator "));
+    const auto generatorLine = manifest.substr(0, manifest.find('\n') + 1);
+    manifest.replace(0, generatorLine.size(), "generator Vandior v0.0.0 git sha: 0000000\n");
+    REQUIRE(vnd::FileCreationResult::createFileFromPath(manifestPath, std::string_view{manifest}).success());
+    {
+        vnd::Transpiler transpiler{input, "input.vn"};
+        const auto files = transpiler.transpileUnits(2);
+        REQUIRE(files.size() == 4);
+        REQUIRE(std::ranges::none_of(files, &vnd::Transpiler::GeneratedFile::reused));
+        REQUIRE_THAT(files[2].code, EndsWith("return 1\n}\n"));
+    }
+    REQUIRE(vnd::readFromFile(manifestPath.string()).starts_with(generatorLine));
+    {
+        vnd::Transpiler transpiler{input, "input.vn"};
+        const auto files = transpiler.transpileUnits(2);
+        REQUIRE(files[2].reused);
+        REQUIRE(files[3].reused);
+    }
+}
+
+TEST_CASE("Transpiler transpiles 100k-term expressions without recursion", "[transpiler]") {
+    [[maybe_unused]] auto unused = fs::remove_all(fs::path(VANDIOR_BUILDFOLDER));
+    constexpr std::size_t depth = 100000;
+    std::string chain = "x = 0";
+    for(std::size_t term = 1; term < depth; ++term) { chain += term % 2 == 0 ? " - b" : " + -c"; }
+    chain += "\ny = " + std::string(depth, '!') + "a";
+    vnd::Transpiler transpiler{chain, "input.vn"};
+    REQUIRE(transpiler.transpile() == chain + "\n");
+}
+
+TEST_CASE("Transpiler transpile nested index instruction", "[transpiler]") {
+    [[maybe_unused]] auto unused = fs::remove_all(fs::path(VANDIOR_BUILDFOLDER));
+    vnd::Transpiler transpiler{"m = i32[2][]{{1}, {2}}\nm[f(1)] = {1, 2}", "input.vn"};
+    const auto code = transpiler.transpile();
+    REQUIRE(code == "m = vnd::array<vnd::vector<int32_t>, 2>({{1}, {2}})\nvnd::array<m, f(1)> = {1, 2}\n");
 }
 
 TEST_CASE("Transpiler transpile structure instructions", "[transpiler]") {
@@ -3280,6 +4284,47 @@ TEST_CASE("Transpiler transpile return instructions", "[transpiler]") {
     REQUIRE(code == "return true\n");
 }
 
+TEST_CASE("CompilationUnit lexes and parses once for every consumer", "[compilationUnit]") {
+    [[maybe_unused]] auto unused = fs::remove_all(fs::path(VANDIOR_BUILDFOLDER));
+    const std::string_view input = "var a: i8 = 1 + b[2]\nfun f(x: i32) i8 {\nreturn x\n}";
+    vnd::CompilationUnit unit{std::string{input}, "input.vn"};
+    REQUIRE(unit.source() == input);
+    REQUIRE(unit.fileName() == "input.vn");
+    const auto &tokens = unit.tokens();
+    REQUIRE(tokens.size() == 4);
+    const auto &statements = unit.statements();
+    REQUIRE(&unit.tokens() == &tokens);
+    REQUIRE(&unit.statements() == &statements);
+    REQUIRE(statements.size() == tokens.size());
+    REQUIRE(unit.flatAST().statementCount() == statements.size());
+    REQUIRE(statements[0].get_root()->get_token().getValue().data() == unit.source().data());
+
+    vnd::Transpiler borrowing{unit};
+    const auto code = borrowing.transpile();
+    REQUIRE(&unit.statements() == &statements);
+    [[maybe_unused]] auto unused2 = fs::remove_all(fs::path(VANDIOR_BUILDFOLDER));
+    vnd::Transpiler owning{input, "input.vn"};
+    REQUIRE(code == owning.transpile());
+}
+
+TEST_CASE("CompilationUnit flattens a 100k-term expression without recursion", "[compilationUnit]") {
+    constexpr std::size_t depth = 100000;
+    std::string chain = "x = a";
+    for(std::size_t term = 1; term < depth; ++term) { chain += " + b"; }
+    vnd::CompilationUnit unit{std::move(chain), "input.vn"};
+    const auto &ast = unit.flatAST();
+    REQUIRE(ast.statementCount() == 1);
+    // x, '=' and then the left spine of the chain with one 'b' on the right of every '+'.
+    REQUIRE(ast.size() == 2 * depth + 1);
+    auto node = ast.child(ast.statementRoot(0), vnd::NodeRole::Right);
+    std::size_t additions = 0;
+    for(; ast.kind(node) == vnd::NodeKind::BinaryExpression; node = ast.child(node, vnd::NodeRole::Left)) {
+        if(ast.text(node) == "+" && ast.text(ast.child(node, vnd::NodeRole::Right)) == "b") { ++additions; }
+    }
+    REQUIRE(additions == depth - 1);
+    REQUIRE(ast.text(node) == "a");
+}
+
 // clang-format off
 // NOLINTEND(*-include-cleaner, *-avoid-magic-numbers, *-magic-numbers, *-unchecked-optional-access, *-avoid-do-while, *-use-anonymous-namespace, *-qualified-auto, *-suspicious-stringview-data-usage, *-err58-cpp, *-function-cognitive-complexity, *-macro-usage, *-unnecessary-copy-initialization)
 // clang-format on
\ No newline at end of file